@@ -25,7 +25,7 @@ public class OBGridInventory : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core", "UMG",
+				"Core", "UMG", "Slate", "SlateCore",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -36,8 +36,6 @@ public class OBGridInventory : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
-				"Slate",
-				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
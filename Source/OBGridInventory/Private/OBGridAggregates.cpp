@@ -0,0 +1,287 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridAggregates.h"
+
+#include "OBGridItemTypes.h"
+#include "StructUtils/InstancedStruct.h"
+
+void FOBGridAggregateSet::Register(const FOBGridAggregateSpec& Spec)
+{
+	Unregister(Spec.AggregateName);
+	Specs.Add(Spec);
+	Aggregates.AddDefaulted();
+	PropertyCache.AddDefaulted();
+}
+
+bool FOBGridAggregateSet::Unregister(const FName AggregateName)
+{
+	const int32 AggregateIndex = FindAggregateIndex(AggregateName);
+	if (AggregateIndex == INDEX_NONE) return false;
+
+	Specs.RemoveAt(AggregateIndex);
+	Aggregates.RemoveAt(AggregateIndex);
+	PropertyCache.RemoveAt(AggregateIndex);
+	return true;
+}
+
+void FOBGridAggregateSet::AddPayload(const FConstStructView Payload, const int32 AggregateIndex)
+{
+	for (int32 Index = 0; Index < Aggregates.Num(); ++Index)
+	{
+		if (AggregateIndex != INDEX_NONE && Index != AggregateIndex) continue;
+		if (double Value = 0.0; GetContribution(Index, Payload, Value))
+		{
+			Apply(Index, Value, true);
+		}
+	}
+}
+
+void FOBGridAggregateSet::RemovePayload(const FConstStructView Payload)
+{
+	for (int32 Index = 0; Index < Aggregates.Num(); ++Index)
+	{
+		if (double Value = 0.0; GetContribution(Index, Payload, Value))
+		{
+			Apply(Index, Value, false);
+		}
+	}
+}
+
+void FOBGridAggregateSet::ResetValues()
+{
+	for (FAggregate& Aggregate : Aggregates)
+	{
+		Aggregate = FAggregate();
+	}
+}
+
+bool FOBGridAggregateSet::GetValue(const FName AggregateName, double& OutValue) const
+{
+	OutValue = 0.0;
+	const int32 AggregateIndex = FindAggregateIndex(AggregateName);
+	if (AggregateIndex == INDEX_NONE) return false;
+
+	const EOBGridAggregateOp Op = Specs[AggregateIndex].Op;
+	if ((Op == EOBGridAggregateOp::Min || Op == EOBGridAggregateOp::Max) &&
+		Aggregates[AggregateIndex].NumContributors == 0)
+	{
+		return false;
+	}
+	OutValue = GetCurrentValue(AggregateIndex);
+	return true;
+}
+
+bool FOBGridAggregateSet::CheckRules(const TArray<FOBGridCapacityRule>& Rules, const FConstStructView NewPayload,
+									 const FConstStructView OldPayload, FName& OutViolatedRule) const
+{
+	OutViolatedRule = NAME_None;
+	for (const FOBGridCapacityRule& Rule : Rules)
+	{
+		const int32 AggregateIndex = FindAggregateIndex(Rule.AggregateName);
+		if (AggregateIndex == INDEX_NONE) continue;
+
+		double NewValue = 0.0;
+		if (!GetContribution(AggregateIndex, NewPayload, NewValue)) continue;
+
+		const double Current = GetCurrentValue(AggregateIndex);
+		double Projected = NewValue;
+		switch (Specs[AggregateIndex].Op)
+		{
+		case EOBGridAggregateOp::Sum:
+		case EOBGridAggregateOp::Count:
+			{
+				double OldValue = 0.0;
+				Projected = Current + NewValue -
+					(GetContribution(AggregateIndex, OldPayload, OldValue) ? OldValue : 0.0);
+				break;
+			}
+		case EOBGridAggregateOp::Max:
+			Projected = Aggregates[AggregateIndex].NumContributors > 0 ? FMath::Max(Current, NewValue) : NewValue;
+			break;
+		case EOBGridAggregateOp::Min:
+			Projected = Aggregates[AggregateIndex].NumContributors > 0 ? FMath::Min(Current, NewValue) : NewValue;
+			break;
+		}
+
+		if (Projected > Rule.MaxValue && Projected > Current + UE_DOUBLE_KINDA_SMALL_NUMBER)
+		{
+			OutViolatedRule = Rule.AggregateName;
+			return false;
+		}
+	}
+	return true;
+}
+
+int32 FOBGridAggregateSet::GetAcceptableQuantity(const TArray<FOBGridCapacityRule>& Rules,
+												 const FConstStructView UnitPayload, const int32 Quantity) const
+{
+	int32 Acceptable = Quantity;
+	for (const FOBGridCapacityRule& Rule : Rules)
+	{
+		const int32 AggregateIndex = FindAggregateIndex(Rule.AggregateName);
+		if (AggregateIndex == INDEX_NONE || !Specs[AggregateIndex].bScaleByQuantity) continue;
+		if (const EOBGridAggregateOp Op = Specs[AggregateIndex].Op;
+			Op != EOBGridAggregateOp::Sum && Op != EOBGridAggregateOp::Count)
+		{
+			continue;
+		}
+
+		// GetContribution scales by the payload's own quantity; work per unit.
+		double StackValue = 0.0;
+		const FOBGridStackablePayload* Stack = UnitPayload.GetPtr<FOBGridStackablePayload>();
+		if (!Stack || Stack->Quantity <= 0 || !GetContribution(AggregateIndex, UnitPayload, StackValue)) continue;
+
+		const double UnitValue = StackValue / Stack->Quantity;
+		if (UnitValue <= UE_DOUBLE_KINDA_SMALL_NUMBER) continue;
+
+		const double Room = Rule.MaxValue - GetCurrentValue(AggregateIndex);
+		const int32 Fitting = Room > 0.0
+			? static_cast<int32>(FMath::Min(FMath::FloorToDouble(Room / UnitValue + UE_DOUBLE_KINDA_SMALL_NUMBER),
+											static_cast<double>(MAX_int32)))
+			: 0;
+		Acceptable = FMath::Min(Acceptable, Fitting);
+	}
+	return FMath::Max(Acceptable, 0);
+}
+
+SIZE_T FOBGridAggregateSet::GetAllocatedSize() const
+{
+	SIZE_T Bytes = Specs.GetAllocatedSize() + Aggregates.GetAllocatedSize() + PropertyCache.GetAllocatedSize();
+	for (const FAggregate& Aggregate : Aggregates)
+	{
+		Bytes += Aggregate.ValueCounts.GetAllocatedSize();
+	}
+	for (const TMap<TObjectKey<UScriptStruct>, const FProperty*>& Cache : PropertyCache)
+	{
+		Bytes += Cache.GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+void FOBGridAggregateSet::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FOBGridAggregateSpec& Spec : Specs)
+	{
+		Collector.AddReferencedObject(Spec.PayloadStruct);
+	}
+}
+
+// --- Internal ---
+
+int32 FOBGridAggregateSet::FindAggregateIndex(const FName AggregateName) const
+{
+	return Specs.IndexOfByPredicate([AggregateName](const FOBGridAggregateSpec& Spec)
+	{
+		return Spec.AggregateName == AggregateName;
+	});
+}
+
+bool FOBGridAggregateSet::GetContribution(const int32 AggregateIndex, const FConstStructView Payload,
+										  double& OutValue) const
+{
+	OutValue = 0.0;
+	const UScriptStruct* ScriptStruct = Payload.GetScriptStruct();
+	const uint8* Memory = Payload.GetMemory();
+	if (!ScriptStruct || !Memory) return false;
+
+	const FOBGridAggregateSpec& Spec = Specs[AggregateIndex];
+	if (Spec.PayloadStruct && !ScriptStruct->IsChildOf(Spec.PayloadStruct)) return false;
+
+	if (Spec.Op == EOBGridAggregateOp::Count)
+	{
+		OutValue = 1.0;
+	}
+	else
+	{
+		const FProperty* Property = ResolveProperty(AggregateIndex, ScriptStruct);
+		if (!Property) return false;
+
+		const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Memory);
+		if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			OutValue = NumericProperty->IsFloatingPoint()
+				? NumericProperty->GetFloatingPointPropertyValue(ValuePtr)
+				: static_cast<double>(NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+		}
+		else
+		{
+			OutValue = CastFieldChecked<FBoolProperty>(Property)->GetPropertyValue(ValuePtr) ? 1.0 : 0.0;
+		}
+	}
+
+	if (Spec.bScaleByQuantity)
+	{
+		if (const FOBGridStackablePayload* Stack = Payload.GetPtr<FOBGridStackablePayload>())
+		{
+			OutValue *= Stack->Quantity;
+		}
+	}
+	return true;
+}
+
+const FProperty* FOBGridAggregateSet::ResolveProperty(const int32 AggregateIndex,
+													   const UScriptStruct* PayloadStruct) const
+{
+	TMap<TObjectKey<UScriptStruct>, const FProperty*>& Cache = PropertyCache[AggregateIndex];
+	const TObjectKey<UScriptStruct> StructKey(PayloadStruct);
+	if (const FProperty* const* CachedProperty = Cache.Find(StructKey)) return *CachedProperty;
+
+	const FProperty* Property = FindFProperty<FProperty>(PayloadStruct, Specs[AggregateIndex].PropertyName);
+	if (Property && !Property->IsA<FNumericProperty>() && !Property->IsA<FBoolProperty>())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%hs] - Aggregate '%s': '%s.%s' is neither numeric nor bool, ignored."),
+			   __FUNCTION__, *Specs[AggregateIndex].AggregateName.ToString(), *PayloadStruct->GetName(),
+			   *Property->GetName());
+		Property = nullptr;
+	}
+	Cache.Add(StructKey, Property);
+	return Property;
+}
+
+void FOBGridAggregateSet::Apply(const int32 AggregateIndex, const double Value, const bool bAdd)
+{
+	FAggregate& Aggregate = Aggregates[AggregateIndex];
+	Aggregate.NumContributors += bAdd ? 1 : -1;
+
+	const EOBGridAggregateOp Op = Specs[AggregateIndex].Op;
+	if (Op == EOBGridAggregateOp::Sum || Op == EOBGridAggregateOp::Count)
+	{
+		// Reset exactly once nothing contributes, so floating point drift does not accumulate forever.
+		Aggregate.Sum = Aggregate.NumContributors > 0 ? Aggregate.Sum + (bAdd ? Value : -Value) : 0.0;
+		return;
+	}
+
+	const bool bIsMin = Op == EOBGridAggregateOp::Min;
+	if (bAdd)
+	{
+		++Aggregate.ValueCounts.FindOrAdd(Value);
+		Aggregate.Extreme = Aggregate.NumContributors == 1
+			? Value
+			: (bIsMin ? FMath::Min(Aggregate.Extreme, Value) : FMath::Max(Aggregate.Extreme, Value));
+		return;
+	}
+
+	int32* Count = Aggregate.ValueCounts.Find(Value);
+	if (!Count) return;
+	if (--*Count > 0) return;
+
+	Aggregate.ValueCounts.Remove(Value);
+	if (Value != Aggregate.Extreme || Aggregate.ValueCounts.IsEmpty()) return;
+
+	// The last payload holding the extreme left: rescan the distinct values.
+	bool bFirst = true;
+	for (const TPair<double, int32>& Pair : Aggregate.ValueCounts)
+	{
+		Aggregate.Extreme = bFirst ? Pair.Key : (bIsMin ? FMath::Min(Aggregate.Extreme, Pair.Key)
+														 : FMath::Max(Aggregate.Extreme, Pair.Key));
+		bFirst = false;
+	}
+}
+
+double FOBGridAggregateSet::GetCurrentValue(const int32 AggregateIndex) const
+{
+	const FAggregate& Aggregate = Aggregates[AggregateIndex];
+	const EOBGridAggregateOp Op = Specs[AggregateIndex].Op;
+	if (Op == EOBGridAggregateOp::Sum || Op == EOBGridAggregateOp::Count) return Aggregate.Sum;
+	return Aggregate.NumContributors > 0 ? Aggregate.Extreme : 0.0;
+}
@@ -3,6 +3,7 @@
 
 #include "OBGridBackgroundWidget.h"
 
+#include "OBGridPainting.h"
 #include "Components/PanelWidget.h"
 
 void UOBGridBackgroundWidget::UpdateGridParameters(const FOBGridInventoryConfig InGridConfig)
@@ -15,6 +16,7 @@ void UOBGridBackgroundWidget::UpdateGridParameters(const FOBGridInventoryConfig
 	BorderLineColor = InGridConfig.BorderLineColor;
 	BorderLineThickness = FMath::Max(0.0f, InGridConfig.BorderLineThickness);
 	bIsShowNameOnTopLeftCorner = InGridConfig.bIsShowNameOnTopLeftCorner;
+	InGridConfig.BuildCellSections(NumRows, NumColumns, CellSections);
 	// Trigger a repaint when configuration changes
 	Invalidate(EInvalidateWidgetReason::Paint);
 }
@@ -38,8 +40,6 @@ int32 UOBGridBackgroundWidget::NativePaint(const FPaintArgs& Args, const FGeomet
 	const float Scale = FMath::Min(LocalSize.X / TargetWidth, LocalSize.Y / TargetHeight);
 
 	const float ScaledCellSize = CellSize * Scale;
-	const float ScaledMaxX = NumColumns * ScaledCellSize;
-	const float ScaledMaxY = NumRows * ScaledCellSize;
 
 	const float ScaledGridLineThickness = FMath::Max(1.0f, GridLineThickness * Scale);
 	const float ScaledBorderThickness = FMath::Max(1.0f, BorderLineThickness * Scale);
@@ -53,46 +53,16 @@ int32 UOBGridBackgroundWidget::NativePaint(const FPaintArgs& Args, const FGeomet
 		return CurrentLayerId;
 	}
 
-	TArray<FVector2D> LinePoints;
-	LinePoints.SetNumUninitialized(2);
-
-	// --- Draw Vertical Lines & Left/Right Border ---
-	for (int32 X = 0; X <= NumColumns; ++X)
-	{
-		const float LineX = X * ScaledCellSize;
-		LinePoints[0] = FVector2D(LineX, 0);
-		LinePoints[1] = FVector2D(LineX, ScaledMaxY);
-
-		// TÙY CHỈNH MỚI: Chọn độ dày và màu phù hợp
-		const bool bIsBorder = (X == 0 || X == NumColumns);
-		const float CurrentThickness = bIsBorder ? ScaledBorderThickness : ScaledGridLineThickness;
-
-		if (const FLinearColor& CurrentColor = bIsBorder ? BorderLineColor : GridLineColor;
-			CurrentThickness > 0 && CurrentColor.A > 0)
-		{
-			FSlateDrawElement::MakeLines(OutDrawElements, CurrentLayerId, PaintGeometry, LinePoints,
-			                             ESlateDrawEffect::None, CurrentColor, false, CurrentThickness);
-		}
-	}
-
-	// --- Draw Horizontal Lines & Top/Bottom Border ---
-	for (int32 Y = 0; Y <= NumRows; ++Y)
-	{
-		const float LineY = Y * ScaledCellSize;
-		LinePoints[0] = FVector2D(0, LineY);
-		LinePoints[1] = FVector2D(ScaledMaxX, LineY);
-
-		// TÙY CHỈNH MỚI: Chọn độ dày và màu phù hợp
-		const bool bIsBorder = (Y == 0 || Y == NumRows);
-		const float CurrentThickness = bIsBorder ? ScaledBorderThickness : ScaledGridLineThickness;
-
-		if (const FLinearColor& CurrentColor = bIsBorder ? BorderLineColor : GridLineColor;
-			CurrentThickness > 0 && CurrentColor.A > 0)
-		{
-			FSlateDrawElement::MakeLines(OutDrawElements, CurrentLayerId, PaintGeometry, LinePoints,
-			                             ESlateDrawEffect::None, CurrentColor, false, CurrentThickness);
-		}
-	}
+	OBGridPainting::FGridLineParams LineParams;
+	LineParams.NumRows = NumRows;
+	LineParams.NumColumns = NumColumns;
+	LineParams.ScaledCellSize = ScaledCellSize;
+	LineParams.GridLineThickness = ScaledGridLineThickness;
+	LineParams.BorderLineThickness = ScaledBorderThickness;
+	LineParams.GridLineColor = GridLineColor;
+	LineParams.BorderLineColor = BorderLineColor;
+	LineParams.CellSections = CellSections;
+	OBGridPainting::PaintGridLines(LineParams, AllottedGeometry, OutDrawElements, CurrentLayerId);
 
 	// --- Draw Debug Text (Design-time only) ---
 	if (IsDesignTime() && bIsShowNameOnTopLeftCorner)
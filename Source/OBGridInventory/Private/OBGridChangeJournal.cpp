@@ -0,0 +1,39 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridChangeJournal.h"
+
+int64 FOBGridChangeJournal::Append(const EOBGridChangeType Type, const int32 ItemId, const int32 Row,
+								   const int32 Column, const int32 RowSpan, const int32 ColumnSpan)
+{
+	if (Records.Num() >= Capacity * 2)
+	{
+		Records.RemoveAt(0, Records.Num() - Capacity, EAllowShrinking::No);
+	}
+
+	FOBGridChangeRecord& Record = Records.AddDefaulted_GetRef();
+	Record.Sequence = NextSequence++;
+	Record.Type = Type;
+	Record.ItemId = ItemId;
+	Record.Row = Row;
+	Record.Column = Column;
+	Record.RowSpan = RowSpan;
+	Record.ColumnSpan = ColumnSpan;
+	return Record.Sequence;
+}
+
+bool FOBGridChangeJournal::GetChangesSince(const int64 SinceSequence,
+										   TConstArrayView<FOBGridChangeRecord>& OutRecords) const
+{
+	OutRecords = TConstArrayView<FOBGridChangeRecord>();
+	if (Records.IsEmpty() || SinceSequence >= GetLatestSequence())
+	{
+		return SinceSequence <= GetLatestSequence();
+	}
+
+	const int64 FirstWanted = FMath::Max<int64>(SinceSequence + 1, 1);
+	if (FirstWanted < Records[0].Sequence) return false;
+
+	const int32 StartIndex = static_cast<int32>(FirstWanted - Records[0].Sequence);
+	OutRecords = MakeArrayView(Records).Slice(StartIndex, Records.Num() - StartIndex);
+	return true;
+}
@@ -0,0 +1,201 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridFitSolver.h"
+
+#include <atomic>
+
+#include "Async/ParallelFor.h"
+
+namespace OBGridFitSolver
+{
+	enum class EItemOrder : uint8
+	{
+		AsRequested,
+		LargestAreaFirst,
+		LongestSideFirst,
+		TallestFirst,
+		WidestFirst,
+		Count
+	};
+
+	enum class EContainerOrder : uint8
+	{
+		AsGiven,
+		MostFreeCellsFirst,
+		FewestFreeCellsFirst,
+		Count
+	};
+
+	TArray<int32> MakeItemOrder(const TArray<FOBGridFitRequest>& Items, const EItemOrder Order)
+	{
+		TArray<int32> Indices;
+		Indices.Reserve(Items.Num());
+		for (int32 i = 0; i < Items.Num(); ++i)
+		{
+			Indices.Add(i);
+		}
+
+		auto SortBy = [&Indices, &Items](auto KeyFunc)
+		{
+			Indices.StableSort([&Items, &KeyFunc](const int32 A, const int32 B)
+			{
+				return KeyFunc(Items[A]) > KeyFunc(Items[B]);
+			});
+		};
+
+		switch (Order)
+		{
+		case EItemOrder::LargestAreaFirst:
+			SortBy([](const FOBGridFitRequest& Item) { return Item.ItemRows * Item.ItemCols; });
+			break;
+		case EItemOrder::LongestSideFirst:
+			SortBy([](const FOBGridFitRequest& Item) { return FMath::Max(Item.ItemRows, Item.ItemCols); });
+			break;
+		case EItemOrder::TallestFirst:
+			SortBy([](const FOBGridFitRequest& Item) { return Item.ItemRows; });
+			break;
+		case EItemOrder::WidestFirst:
+			SortBy([](const FOBGridFitRequest& Item) { return Item.ItemCols; });
+			break;
+		default:
+			break;
+		}
+		return Indices;
+	}
+
+	TArray<int32> MakeContainerOrder(const TArray<int32>& FreeCells, const EContainerOrder Order)
+	{
+		TArray<int32> Indices;
+		Indices.Reserve(FreeCells.Num());
+		for (int32 i = 0; i < FreeCells.Num(); ++i)
+		{
+			Indices.Add(i);
+		}
+
+		if (Order == EContainerOrder::MostFreeCellsFirst)
+		{
+			Indices.StableSort([&FreeCells](const int32 A, const int32 B) { return FreeCells[A] > FreeCells[B]; });
+		}
+		else if (Order == EContainerOrder::FewestFreeCellsFirst)
+		{
+			Indices.StableSort([&FreeCells](const int32 A, const int32 B) { return FreeCells[A] < FreeCells[B]; });
+		}
+		return Indices;
+	}
+
+	/** Greedy first-fit of every item, in the given orders, on private copies of the containers. */
+	bool TryStrategy(const TArray<FOBGridOccupancy>& Containers, const TArray<FOBGridFitRequest>& Items,
+					 const TArray<int32>& ItemOrder, const TArray<int32>& ContainerOrder,
+					 TArray<FOBGridFitPlacement>& OutPlacements)
+	{
+		TArray<FOBGridOccupancy> Working = Containers;
+		OutPlacements.SetNum(Items.Num());
+
+		// Ids only need to be non-free inside this scratch copy.
+		constexpr int32 ScratchId = MAX_int32;
+		for (const int32 ItemIndex : ItemOrder)
+		{
+			const FOBGridFitRequest& Item = Items[ItemIndex];
+			bool bPlaced = false;
+			for (const int32 ContainerIndex : ContainerOrder)
+			{
+				int32 Row = -1;
+				int32 Col = -1;
+				if (Working[ContainerIndex].FindFreeSlot(Item.ItemRows, Item.ItemCols, Row, Col))
+				{
+					Working[ContainerIndex].Fill(Row, Col, Item.ItemRows, Item.ItemCols, ScratchId);
+					FOBGridFitPlacement& Placement = OutPlacements[ItemIndex];
+					Placement.RequestIndex = ItemIndex;
+					Placement.ContainerIndex = ContainerIndex;
+					Placement.Row = Row;
+					Placement.Column = Col;
+					bPlaced = true;
+					break;
+				}
+			}
+			if (!bPlaced) return false;
+		}
+		return true;
+	}
+}
+
+FOBGridPlacementPlan FOBGridFitSolver::Solve(const TArray<FOBGridOccupancy>& Containers,
+											 const TArray<FOBGridFitRequest>& Items)
+{
+	using namespace OBGridFitSolver;
+
+	FOBGridPlacementPlan Plan;
+	if (Items.IsEmpty())
+	{
+		Plan.bFeasible = true;
+		return Plan;
+	}
+	if (Containers.IsEmpty()) return Plan;
+
+	// Cheap rejection before spawning any work: total area and per-item bounds.
+	TArray<int32> FreeCells;
+	FreeCells.Reserve(Containers.Num());
+	int64 TotalFree = 0;
+	for (const FOBGridOccupancy& Container : Containers)
+	{
+		TotalFree += FreeCells.Add_GetRef(Container.CountFreeCells());
+	}
+	int64 TotalRequired = 0;
+	for (const FOBGridFitRequest& Item : Items)
+	{
+		if (Item.ItemRows < 1 || Item.ItemCols < 1) return Plan;
+		TotalRequired += static_cast<int64>(Item.ItemRows) * Item.ItemCols;
+	}
+	if (TotalRequired > TotalFree) return Plan;
+
+	constexpr int32 NumItemOrders = static_cast<int32>(EItemOrder::Count);
+	constexpr int32 NumContainerOrders = static_cast<int32>(EContainerOrder::Count);
+	constexpr int32 NumStrategies = NumItemOrders * NumContainerOrders;
+
+	TArray<TArray<FOBGridFitPlacement>> Results;
+	Results.SetNum(NumStrategies);
+	TArray<bool> Succeeded;
+	Succeeded.SetNumZeroed(NumStrategies);
+	std::atomic<int32> BestStrategy{NumStrategies};
+
+	ParallelFor(NumStrategies, [&](const int32 StrategyIndex)
+	{
+		// A higher priority strategy already succeeded; no need to keep working.
+		if (BestStrategy.load(std::memory_order_relaxed) < StrategyIndex) return;
+
+		const TArray<int32> ItemOrder = MakeItemOrder(Items, static_cast<EItemOrder>(StrategyIndex / NumContainerOrders));
+		const TArray<int32> ContainerOrder = MakeContainerOrder(
+			FreeCells, static_cast<EContainerOrder>(StrategyIndex % NumContainerOrders));
+
+		if (TryStrategy(Containers, Items, ItemOrder, ContainerOrder, Results[StrategyIndex]))
+		{
+			Succeeded[StrategyIndex] = true;
+			int32 Current = BestStrategy.load(std::memory_order_relaxed);
+			while (StrategyIndex < Current &&
+				!BestStrategy.compare_exchange_weak(Current, StrategyIndex, std::memory_order_relaxed))
+			{
+			}
+		}
+	});
+
+	for (int32 StrategyIndex = 0; StrategyIndex < NumStrategies; ++StrategyIndex)
+	{
+		if (Succeeded[StrategyIndex])
+		{
+			Plan.bFeasible = true;
+			Plan.Placements = MoveTemp(Results[StrategyIndex]);
+			break;
+		}
+	}
+	return Plan;
+}
+
+UE::Tasks::TTask<FOBGridPlacementPlan> FOBGridFitSolver::SolveAsync(TArray<FOBGridOccupancy> Containers,
+																	 TArray<FOBGridFitRequest> Items)
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION,
+							 [Containers = MoveTemp(Containers), Items = MoveTemp(Items)]()
+							 {
+								 return Solve(Containers, Items);
+							 });
+}
@@ -2,17 +2,21 @@
 
 #include "OBGridInventory.h"
 
+#include "OBGridTrace.h"
+
 #define LOCTEXT_NAMESPACE "FOBGridInventoryModule"
 
 void FOBGridInventoryModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	OBGridTrace::StartFromCommandLine();
 }
 
 void FOBGridInventoryModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FOBGridTraceRecorder::Get().Stop();
 }
 
 #undef LOCTEXT_NAMESPACE
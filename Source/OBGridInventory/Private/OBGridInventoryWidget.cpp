@@ -3,15 +3,33 @@
 #include "OBGridInventoryWidget.h"
 
 #include "OBGridItemWidgetInterface.h"
+#include "OBGridPanel.h"
+#include "OBGridPanelSlot.h"
+#include "OBGridTrace.h"
 #include "Components/GridPanel.h"
 #include "Components/GridSlot.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Slate/SObjectWidget.h"
+
+UOBGridInventoryWidget::UOBGridInventoryWidget(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	OwnedItemState = CreateDefaultSubobject<UOBGridItemState>(TEXT("ItemState"));
+	ItemState = OwnedItemState;
+}
 
 // --- Overrides ---
 
 void UOBGridInventoryWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
-	SetupGridPanelDimensions();
+	// The item state and item widgets survive destruct/construct cycles (tab switches, menu toggles). Only
+	// reconcile what changed while off screen: GridConfig written directly, or state changes this view deferred.
+	if (ItemState == OwnedItemState)
+	{
+		ReconcileConfigWithState();
+	}
+	ApplyStateChanges();
 	UpdateGridBackground();
 }
 
@@ -29,6 +47,11 @@ void UOBGridInventoryWidget::NativePreConstruct()
 void UOBGridInventoryWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
+	LastPresentedFrame = GFrameCounter;
+	if (bPresentationDirty)
+	{
+		ApplyStateChanges();
+	}
 	if (const FVector2D CurrentAllocatedSize = MyGeometry.GetLocalSize();
 		!CurrentAllocatedSize.Equals(LastKnownAllocatedSize, 0.5f))
 	{
@@ -58,322 +81,1443 @@ void UOBGridInventoryWidget::NativeOnInitialized()
 		CurrentGridScale = 1.0f;
 	}
 	LastKnownAllocatedSize = FVector2D(-1.0f, -1.0f);
+	OwnedItemState->SetJournalCapacity(ChangeJournalCapacity);
+	for (const FOBGridAggregateSpec& Spec : Aggregates)
+	{
+		OwnedItemState->RegisterAggregate(Spec);
+	}
+	OwnedItemState->SetCapacityRules(CapacityRules);
+	OwnedItemState->SetPublishSnapshots(bPublishSnapshots);
+	OwnedItemState->SetInternPayloads(bInternPayloads);
+	if (!ItemState->OnChanged.IsBoundToObject(this))
+	{
+		ItemState->OnChanged.AddUObject(this, &UOBGridInventoryWidget::HandleItemStateChanged);
+	}
+	if (bUsePaintedItems)
+	{
+		if (ItemGridPanel && !IsPaintingItems())
+		{
+			UE_LOG(LogTemp, Warning,
+				   TEXT("[%s::%hs] - Painted items need a UOBGridPanel; '%s' gets one widget per item."),
+				   *GetNameSafe(this), __FUNCTION__, *GetNameSafe(ItemGridPanel));
+		}
+		else if (ItemGridPanel)
+		{
+			// Painted items have no widget of their own: the panel has to receive the mouse to drive hover.
+			ItemGridPanel->SetVisibility(ESlateVisibility::Visible);
+		}
+	}
 	UpdateGridBackground();
 	SetupGridPanelDimensions();
-	UpdateDummyCells();
+}
+
+void UOBGridInventoryWidget::BeginDestroy()
+{
+	if (ItemState)
+	{
+		ItemState->OnChanged.RemoveAll(this);
+	}
+	if (PendingFlushHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingFlushHandle);
+		PendingFlushHandle.Reset();
+	}
+	Super::BeginDestroy();
 }
 
 FNavigationReply UOBGridInventoryWidget::NativeOnNavigation(const FGeometry& MyGeometry,
 															const FNavigationEvent& InNavigationEvent,
 															const FNavigationReply& InDefaultReply)
 {
-	return Super::NativeOnNavigation(MyGeometry, InNavigationEvent, InDefaultReply);
+	const EUINavigation Direction = InNavigationEvent.GetNavigationType();
+	if (Direction != EUINavigation::Left && Direction != EUINavigation::Right &&
+		Direction != EUINavigation::Up && Direction != EUINavigation::Down)
+	{
+		return Super::NativeOnNavigation(MyGeometry, InNavigationEvent, InDefaultReply);
+	}
+
+	// Clicks, SetFocus and moved or removed items all leave FocusedCell behind; start from the focused widget.
+	FindUserFocusedCell(InNavigationEvent.GetUserIndex(), FocusedCell);
+
+	// Step through the grid data instead of letting Slate search every focusable child geometrically.
+	FIntPoint TargetCell = FocusedCell;
+	bool bEscaped = false;
+	if (FindNavigationTarget(Direction, TargetCell, bEscaped))
+	{
+		if (UUserWidget* TargetWidget = ResolveNavigationWidget(TargetCell.Y, TargetCell.X))
+		{
+			FocusedCell = TargetCell;
+			return FNavigationReply::Explicit(TargetWidget->TakeWidget());
+		}
+	}
+	return bEscaped ? Super::NativeOnNavigation(MyGeometry, InNavigationEvent, InDefaultReply)
+					: FNavigationReply::Stop();
+}
+
+FReply UOBGridInventoryWidget::NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+	if (IsPaintingItems())
+	{
+		int32 Row = INDEX_NONE;
+		int32 Column = INDEX_NONE;
+		SetHoveredItem(AbsoluteToCell(InMouseEvent.GetScreenSpacePosition(), Row, Column)
+						   ? GetItemIdAtCell(Row, Column)
+						   : INDEX_NONE);
+	}
+	return Super::NativeOnMouseMove(InGeometry, InMouseEvent);
+}
+
+void UOBGridInventoryWidget::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
+{
+	Super::NativeOnMouseLeave(InMouseEvent);
+	SetHoveredItem(INDEX_NONE);
+}
+
+void UOBGridInventoryWidget::NativeOnRemovedFromFocusPath(const FFocusEvent& InFocusEvent)
+{
+	Super::NativeOnRemovedFromFocusPath(InFocusEvent);
+	SetFocusedItem(INDEX_NONE);
+}
+
+// --- Item State ---
+
+void UOBGridInventoryWidget::SetItemState(UOBGridItemState* NewItemState)
+{
+	if (!NewItemState)
+	{
+		NewItemState = OwnedItemState;
+	}
+	if (NewItemState == ItemState) return;
+
+	ItemState->OnChanged.RemoveAll(this);
+	ItemState = NewItemState;
+	ItemState->OnChanged.AddUObject(this, &UOBGridInventoryWidget::HandleItemStateChanged);
+	// Journal listeners of this view continue from the new state's history.
+	LastFlushedSequence = ItemState->GetChangeJournal().GetLatestSequence();
+	RebuildPresentation();
+}
+
+void UOBGridInventoryWidget::ApplyStateChanges()
+{
+	if (!ItemGridPanel) return;
+	if (bIsApplyingChanges)
+	{
+		// A listener changed the state from inside one of our events; the outer loop picks the records up.
+		bPresentationDirty = true;
+		return;
+	}
+
+	TGuardValue<bool> ApplyingGuard(bIsApplyingChanges, true);
+	do
+	{
+		bPresentationDirty = false;
+		TConstArrayView<FOBGridChangeRecord> PendingView;
+		if (!ItemState->GetChangeJournal().GetChangesSince(AppliedSequence, PendingView) ||
+			PendingView.ContainsByPredicate([](const FOBGridChangeRecord& Record)
+			{
+				return Record.Type == EOBGridChangeType::Reset;
+			}))
+		{
+			// The state was rebuilt, or this view fell behind the retained window while hidden.
+			ReconcilePresentation();
+			continue;
+		}
+		// Copy: listeners of the events fired below may append to the journal.
+		const TArray<FOBGridChangeRecord> PendingRecords(PendingView);
+		for (const FOBGridChangeRecord& Record : PendingRecords)
+		{
+			AppliedSequence = Record.Sequence;
+			ApplyChange(Record);
+		}
+	}
+	while (bPresentationDirty);
 }
 
 // --- Grid Configuration ---
 
 void UOBGridInventoryWidget::SetGridRows(const int32 NewGridRows)
 {
-	GridConfig.NumRows = NewGridRows;
-	// Consider refreshing the grid layout after this change
+	ResizeGrid(NewGridRows, GridConfig.NumColumns, DefaultResizePolicy);
 }
 
 void UOBGridInventoryWidget::SetGridColumns(const int32 NewGridColumns)
 {
-	GridConfig.NumColumns = NewGridColumns;
-	// Consider refreshing the grid layout after this change
+	ResizeGrid(GridConfig.NumRows, NewGridColumns, DefaultResizePolicy);
+}
+
+bool UOBGridInventoryWidget::ResizeGrid(const int32 NewRows, const int32 NewColumns,
+										const EOBGridResizePolicy OutOfBoundsPolicy)
+{
+	// The state removes overflowing items before reporting them; keep their widgets for OnItemOverflowed.
+	TMap<int32, UUserWidget*> WidgetsOutOfBounds;
+	if (OutOfBoundsPolicy == EOBGridResizePolicy::Overflow)
+	{
+		for (const TPair<int32, TObjectPtr<UUserWidget>>& Pair : ItemWidgetsById)
+		{
+			if (const FOBGridItemInfo* Info = ItemState->FindItem(Pair.Key);
+				Info && (Info->Row + Info->RowSpan > NewRows || Info->Column + Info->ColumnSpan > NewColumns))
+			{
+				WidgetsOutOfBounds.Add(Pair.Key, Pair.Value);
+			}
+		}
+	}
+
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::ResizeGrid, NewRows, NewColumns,
+							static_cast<int32>(OutOfBoundsPolicy));
+	TArray<FOBGridItemInfo> OverflowedItems;
+	if (!ItemState->Resize(NewRows, NewColumns, OutOfBoundsPolicy, OverflowedItems)) return false;
+
+	ApplyStateChanges();
+	Trace.SetSucceeded(true);
+	GridConfig.NumRows = ItemState->GetNumRows();
+	GridConfig.NumColumns = ItemState->GetNumColumns();
+	for (const FOBGridItemInfo& OverflowedInfo : OverflowedItems)
+	{
+		OnItemOverflowed.Broadcast(WidgetsOutOfBounds.FindRef(OverflowedInfo.ItemId), OverflowedInfo);
+	}
+	return true;
+}
+
+bool UOBGridInventoryWidget::SetGridLayout(const TArray<FOBGridSection>& NewSections,
+										   const TArray<FIntPoint>& NewDisabledCells)
+{
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::SetGridLayout);
+	Trace.SetLayout(NewSections, NewDisabledCells);
+	if (!ItemState->SetLayout(NewSections, NewDisabledCells)) return false;
+	ApplyStateChanges();
+	Trace.SetSucceeded(true);
+	return true;
+}
+
+bool UOBGridInventoryWidget::SetCellEnabled(const int32 Row, const int32 Column, const bool bEnabled)
+{
+	const FOBGridOccupancy& Occupancy = ItemState->GetOccupancy();
+	if (!Occupancy.IsValidCell(Row, Column)) return false;
+	if (Occupancy.IsCellEnabled(Row, Column) == bEnabled) return true;
+
+	TArray<FIntPoint> NewDisabledCells = ItemState->GetDisabledCells();
+	if (bEnabled)
+	{
+		NewDisabledCells.Remove(FIntPoint(Column, Row));
+	}
+	else
+	{
+		NewDisabledCells.AddUnique(FIntPoint(Column, Row));
+	}
+	return SetGridLayout(ItemState->GetSections(), NewDisabledCells);
+}
+
+// --- Item Management ---
+
+UUserWidget* UOBGridInventoryWidget::AddItemWidget(const FInstancedStruct& ItemPayload, const int32 ItemRows,
+												   const int32 ItemCols,
+												   const TSubclassOf<UUserWidget> CustomItemWidgetClass)
+{
+	return AcquireItemWidget(AddItem(ItemPayload, ItemRows, ItemCols, CustomItemWidgetClass),
+							 EOBGridItemWidgetDemand::Pinned);
+}
+
+UUserWidget* UOBGridInventoryWidget::AddItemWidgetToSection(const FName SectionName,
+															const FInstancedStruct& ItemPayload, const int32 ItemRows,
+															const int32 ItemCols,
+															const TSubclassOf<UUserWidget> CustomItemWidgetClass)
+{
+	if (!ValidateAddItemInputs(ItemRows, ItemCols, CustomItemWidgetClass))
+	{
+		return nullptr;
+	}
+
+	const int32 SectionIndex = ItemState->FindSectionIndex(SectionName);
+	if (SectionIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - Unknown section '%s'."), *GetNameSafe(this), __FUNCTION__,
+			   *SectionName.ToString());
+		return nullptr;
+	}
+
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::AddItem, ItemRows, ItemCols, SectionIndex);
+	Trace.SetPayload(ItemPayload);
+	const int32 NewItemId = ItemState->AddItem(ItemPayload, ItemRows, ItemCols, CustomItemWidgetClass, SectionIndex);
+	ApplyStateChanges();
+	Trace.SetResult(NewItemId);
+	return AcquireItemWidget(NewItemId, EOBGridItemWidgetDemand::Pinned);
+}
+
+UUserWidget* UOBGridInventoryWidget::AddItemWidgetAt(const FInstancedStruct& ItemPayload, const int32 ItemRows,
+													 const int32 ItemCols,
+													 const int32 RowTopLeft, const int32 ColTopLeft,
+													 const TSubclassOf<UUserWidget> CustomItemWidgetClass)
+{
+	return AcquireItemWidget(AddItemAt(ItemPayload, ItemRows, ItemCols, RowTopLeft, ColTopLeft, CustomItemWidgetClass),
+							 EOBGridItemWidgetDemand::Pinned);
+}
+
+bool UOBGridInventoryWidget::AddStackableItem(const FInstancedStruct& ItemPayload, FOBGridStackAddResult& OutResult,
+											  const int32 ItemRows, const int32 ItemCols,
+											  const TSubclassOf<UUserWidget> CustomItemWidgetClass)
+{
+	// Merging into existing stacks needs no widget class; only new stacks do.
+	const bool bAllowNewStacks = ValidateAddItemInputs(ItemRows, ItemCols, CustomItemWidgetClass);
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::AddStackableItem, ItemRows, ItemCols, bAllowNewStacks);
+	Trace.SetPayload(ItemPayload);
+	const bool bComplete = ItemState->AddStackableItem(ItemPayload, ItemRows, ItemCols, CustomItemWidgetClass,
+													   bAllowNewStacks, OutResult);
+	ApplyStateChanges();
+	Trace.SetResult(bComplete, OutResult.PlacedItemIds);
+
+	for (FOBGridStackMerge& Merge : OutResult.MergedStacks)
+	{
+		Merge.ItemWidget = GetItemWidgetById(Merge.ItemId);
+	}
+	for (const int32 PlacedItemId : OutResult.PlacedItemIds)
+	{
+		if (UUserWidget* ItemWidget = GetItemWidgetById(PlacedItemId))
+		{
+			OutResult.PlacedWidgets.Add(ItemWidget);
+		}
+	}
+	return bComplete;
+}
+
+bool UOBGridInventoryWidget::SetItemPayload(UUserWidget* ItemWidget, const FInstancedStruct& NewPayload)
+{
+	return SetItemPayloadById(GetItemIdForWidget(ItemWidget), NewPayload);
+}
+
+bool UOBGridInventoryWidget::RemoveItemWidget(UUserWidget* ItemWidgetToRemove)
+{
+	return RemoveItem(GetItemIdForWidget(ItemWidgetToRemove));
+}
+
+void UOBGridInventoryWidget::ClearGrid()
+{
+	if (!ItemGridPanel) return;
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::ClearGrid);
+	ItemState->ClearItems();
+	ApplyStateChanges();
+	Trace.SetSucceeded(true);
+	UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Grid cleared of all items."), *GetNameSafe(this), __FUNCTION__);
+}
+
+bool UOBGridInventoryWidget::MoveItemWidget(UUserWidget* ItemWidgetToMove, const int32 NewRowTopLeft,
+											const int32 NewColTopLeft)
+{
+	return RequestItemMove(GetItemIdForWidget(ItemWidgetToMove), NewRowTopLeft, NewColTopLeft);
+}
+
+// --- Items by Id ---
+
+int32 UOBGridInventoryWidget::AddItem(const FInstancedStruct& ItemPayload, const int32 ItemRows, const int32 ItemCols,
+									  const TSubclassOf<UUserWidget> CustomItemWidgetClass)
+{
+	if (!ValidateAddItemInputs(ItemRows, ItemCols, CustomItemWidgetClass))
+	{
+		return INDEX_NONE;
+	}
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::AddItem, ItemRows, ItemCols, INDEX_NONE);
+	Trace.SetPayload(ItemPayload);
+	const int32 NewItemId = ItemState->AddItem(ItemPayload, ItemRows, ItemCols, CustomItemWidgetClass);
+	ApplyStateChanges();
+	Trace.SetResult(NewItemId);
+	return NewItemId;
+}
+
+int32 UOBGridInventoryWidget::AddItemAt(const FInstancedStruct& ItemPayload, const int32 ItemRows,
+										const int32 ItemCols, const int32 RowTopLeft, const int32 ColTopLeft,
+										const TSubclassOf<UUserWidget> CustomItemWidgetClass)
+{
+	if (!ValidateAddItemInputs(ItemRows, ItemCols, CustomItemWidgetClass))
+	{
+		return INDEX_NONE;
+	}
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::AddItemAt, ItemRows, ItemCols, RowTopLeft, ColTopLeft);
+	Trace.SetPayload(ItemPayload);
+	const int32 NewItemId = ItemState->AddItemAt(ItemPayload, ItemRows, ItemCols, RowTopLeft, ColTopLeft,
+												 CustomItemWidgetClass);
+	ApplyStateChanges();
+	Trace.SetResult(NewItemId);
+	return NewItemId;
+}
+
+bool UOBGridInventoryWidget::RemoveItem(const int32 ItemId)
+{
+	if (!ItemGridPanel) return false;
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::RemoveItem, ItemId);
+	if (!ItemState->RemoveItem(ItemId)) return false;
+	ApplyStateChanges();
+	Trace.SetSucceeded(true);
+	return true;
+}
+
+bool UOBGridInventoryWidget::MoveItem(const int32 ItemId, const int32 NewRowTopLeft, const int32 NewColTopLeft)
+{
+	if (!ItemGridPanel) return false;
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::MoveItem, ItemId, NewRowTopLeft, NewColTopLeft);
+	if (!ItemState->MoveItem(ItemId, NewRowTopLeft, NewColTopLeft)) return false;
+	ApplyStateChanges();
+	Trace.SetSucceeded(true);
+	return true;
+}
+
+bool UOBGridInventoryWidget::RequestItemMove(const int32 ItemId, const int32 NewRowTopLeft, const int32 NewColTopLeft)
+{
+	if (!MoveAuthority) return MoveItem(ItemId, NewRowTopLeft, NewColTopLeft);
+	if (!ItemGridPanel) return false;
+
+	// Presented right away; the authority's answer arrives as a confirm or a rollback on the state. The state traces
+	// the reservation itself.
+	const int32 ReservationId = ItemState->ReserveMove(ItemId, NewRowTopLeft, NewColTopLeft);
+	if (ReservationId == INDEX_NONE) return false;
+	ApplyStateChanges();
+	MoveAuthority->RequestMove(ItemState, ReservationId, ItemId, NewRowTopLeft, NewColTopLeft);
+	return true;
+}
+
+bool UOBGridInventoryWidget::IsItemPending(const int32 ItemId) const
+{
+	return ItemState && ItemState->IsItemPending(ItemId);
+}
+
+bool UOBGridInventoryWidget::SetItemPayloadById(const int32 ItemId, const FInstancedStruct& NewPayload)
+{
+	FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::SetItemPayload, ItemId);
+	Trace.SetPayload(NewPayload);
+	if (!ItemState->SetItemPayload(ItemId, NewPayload)) return false;
+	ApplyStateChanges();
+	Trace.SetSucceeded(true);
+	return true;
+}
+
+bool UOBGridInventoryWidget::GetItemInfoById(const int32 ItemId, FOBGridItemInfo& OutItemInfo) const
+{
+	if (const FOBGridItemInfo* FoundInfo = ItemState->FindItem(ItemId))
+	{
+		OutItemInfo = FoundInfo->WithOwnedPayload();
+		return true;
+	}
+	return false;
+}
+
+int32 UOBGridInventoryWidget::GetItemIdAtCell(const int32 Row, const int32 Column) const
+{
+	return ItemState->GetItemIdAtCell(Row, Column);
+}
+
+int32 UOBGridInventoryWidget::GetItemIdForWidget(UUserWidget* ItemWidget) const
+{
+	const int32* FoundId = ItemWidget ? ItemIdsByWidget.Find(ItemWidget) : nullptr;
+	return FoundId ? *FoundId : INDEX_NONE;
+}
+
+UUserWidget* UOBGridInventoryWidget::GetItemWidgetById(const int32 ItemId) const
+{
+	const TObjectPtr<UUserWidget>* FoundWidget = ItemWidgetsById.Find(ItemId);
+	return FoundWidget ? FoundWidget->Get() : nullptr;
+}
+
+void UOBGridInventoryWidget::GetAllItemIds(TArray<int32>& OutItemIds) const
+{
+	ItemState->GetItems().GenerateKeyArray(OutItemIds);
+}
+
+// --- Painted Items ---
+
+bool UOBGridInventoryWidget::IsPaintingItems() const
+{
+	return bUsePaintedItems && Cast<UOBGridPanel>(ItemGridPanel) != nullptr;
+}
+
+UUserWidget* UOBGridInventoryWidget::AcquireItemWidget(const int32 ItemId, const EOBGridItemWidgetDemand Reason)
+{
+	if (!ItemState->FindItem(ItemId)) return nullptr;
+	if (bPresentationDirty)
+	{
+		// An explicit request for a widget is worth catching up for, even off screen.
+		ApplyStateChanges();
+	}
+	if (!IsPaintingItems()) return GetItemWidgetById(ItemId);
+
+	UUserWidget* ItemWidget = GetItemWidgetById(ItemId);
+	if (!ItemWidget)
+	{
+		ItemWidget = CreateItemWidgetFor(ItemId);
+		if (!ItemWidget) return nullptr;
+	}
+	WidgetDemandsById.FindOrAdd(ItemId) |= Reason;
+	return ItemWidget;
+}
+
+void UOBGridInventoryWidget::ReleaseItemWidget(const int32 ItemId, const EOBGridItemWidgetDemand Reason)
+{
+	if (!IsPaintingItems()) return;
+	EOBGridItemWidgetDemand* Demand = WidgetDemandsById.Find(ItemId);
+	if (!Demand) return;
+
+	*Demand &= ~Reason;
+	if (*Demand == EOBGridItemWidgetDemand::None)
+	{
+		DestroyItemWidgetFor(ItemId, true);
+	}
+}
+
+void UOBGridInventoryWidget::ResolveItemVisual_Implementation(const FOBGridItemInfo& ItemInfo,
+															  FOBGridItemVisual& OutVisual) const
+{
+	if (const FOBGridStackablePayload* Stack = ItemInfo.GetPayload().GetPtr<FOBGridStackablePayload>();
+		Stack && Stack->IsStackable())
+	{
+		OutVisual.QuantityText = FText::AsNumber(Stack->Quantity);
+	}
+}
+
+// --- Querying ---
+
+bool UOBGridInventoryWidget::IsAreaClear(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows,
+										 const int32 ItemCols) const
+{
+	return ItemState->GetOccupancy().IsAreaClear(TopLeftRow, TopLeftCol, ItemRows, ItemCols);
+}
+
+UUserWidget* UOBGridInventoryWidget::GetItemWidgetAtCell(const int32 Row, const int32 Column) const
+{
+	return GetItemWidgetById(GetItemIdAtCell(Row, Column));
+}
+
+bool UOBGridInventoryWidget::IsCellEnabled(const int32 Row, const int32 Column) const
+{
+	return ItemState->GetOccupancy().IsCellEnabled(Row, Column);
+}
+
+FName UOBGridInventoryWidget::GetSectionAt(const int32 Row, const int32 Column) const
+{
+	const int32 SectionIndex = ItemState->GetOccupancy().GetCellSection(Row, Column);
+	const TArray<FOBGridSection>& Sections = ItemState->GetSections();
+	return Sections.IsValidIndex(SectionIndex) ? Sections[SectionIndex].SectionName : NAME_None;
+}
+
+void UOBGridInventoryWidget::GetAllItemWidgets(TArray<UUserWidget*>& OutItemWidgets) const
+{
+	OutItemWidgets.Empty();
+	for (const TPair<int32, TObjectPtr<UUserWidget>>& Pair : ItemWidgetsById)
+	{
+		if (Pair.Value)
+		{
+			OutItemWidgets.Add(Pair.Value);
+		}
+	}
+}
+
+bool UOBGridInventoryWidget::GetItemInfo(UUserWidget* ItemWidget, FOBGridItemInfo& OutItemInfo) const
+{
+	return GetItemInfoById(GetItemIdForWidget(ItemWidget), OutItemInfo);
+}
+
+bool UOBGridInventoryWidget::GetItemAt(const int32 TopLeftRow, const int32 TopLeftCol,
+									   UUserWidget*& OutItemWidget, FInstancedStruct& OutItemPayload) const
+{
+	OutItemWidget = nullptr;
+	OutItemPayload.Reset();
+
+	const int32 ItemId = GetItemIdAtCell(TopLeftRow, TopLeftCol);
+	if (const FOBGridItemInfo* Info = ItemState->FindItem(ItemId);
+		Info && Info->Row == TopLeftRow && Info->Column == TopLeftCol)
+	{
+		OutItemWidget = GetItemWidgetById(ItemId);
+		OutItemPayload = Info->CopyPayload();
+		return true;
+	}
+	return false;
+}
+
+bool UOBGridInventoryWidget::GetChangesSince(const int64 SinceSequence, TArray<FOBGridChangeRecord>& OutRecords) const
+{
+	TConstArrayView<FOBGridChangeRecord> Records;
+	const bool bComplete = ItemState->GetChangeJournal().GetChangesSince(SinceSequence, Records);
+	OutRecords = Records;
+	return bComplete;
+}
+
+bool UOBGridInventoryWidget::GetItemPayload(UUserWidget* ItemWidget, FInstancedStruct& OutItemPayload) const
+{
+	OutItemPayload.Reset();
+	if (const FOBGridItemInfo* FoundInfo = ItemState->FindItem(GetItemIdForWidget(ItemWidget)))
+	{
+		OutItemPayload = FoundInfo->CopyPayload();
+		return true;
+	}
+	return false;
+}
+
+FOBGridMemoryStats UOBGridInventoryWidget::GetMemoryStats(const bool bIncludeItemState) const
+{
+	FOBGridMemoryStats Stats;
+	if (bIncludeItemState)
+	{
+		OBGridMemory::AddItemStateStats(*ItemState, Stats);
+	}
+
+	// Pooled widgets are counted with the live ones: they are still held by this grid.
+	Stats.NumItemWidgets = ItemWidgetsById.Num() + PooledItemWidgets.Num();
+	for (const TPair<int32, TObjectPtr<UUserWidget>>& Pair : ItemWidgetsById)
+	{
+		Stats.ItemWidgetBytes += OBGridMemory::GetWidgetBytes(Pair.Value);
+	}
+	for (const UUserWidget* PooledWidget : PooledItemWidgets)
+	{
+		Stats.ItemWidgetBytes += OBGridMemory::GetWidgetBytes(PooledWidget);
+	}
+
+	for (const TPair<FIntPoint, TWeakObjectPtr<UUserWidget>>& Pair : DummyCellWidgetsMap)
+	{
+		if (const UUserWidget* DummyWidget = Pair.Value.Get())
+		{
+			++Stats.NumDummyWidgets;
+			Stats.DummyWidgetBytes += OBGridMemory::GetWidgetBytes(DummyWidget);
+		}
+	}
+
+	Stats.ItemMapBytes += PresentedItems.GetAllocatedSize() + ItemWidgetsById.GetAllocatedSize() +
+		ItemIdsByWidget.GetAllocatedSize() + WidgetDemandsById.GetAllocatedSize() +
+		PooledItemWidgets.GetAllocatedSize();
+	Stats.DummyMapBytes = DummyCellWidgetsMap.GetAllocatedSize() + DummyCellsByWidget.GetAllocatedSize();
+	return Stats;
+}
+
+// --- Hit Testing ---
+
+bool UOBGridInventoryWidget::AbsoluteToCell(const FVector2D& AbsolutePosition, int32& OutRow, int32& OutColumn) const
+{
+	OutRow = INDEX_NONE;
+	OutColumn = INDEX_NONE;
+	if (!ItemGridPanel) return false;
+	return LocalToCell(ItemGridPanel->GetCachedGeometry().AbsoluteToLocal(AbsolutePosition), OutRow, OutColumn);
+}
+
+bool UOBGridInventoryWidget::LocalToCell(const FVector2D& LocalPosition, int32& OutRow, int32& OutColumn) const
+{
+	OutRow = INDEX_NONE;
+	OutColumn = INDEX_NONE;
+	const float ScaledCellSize = GridConfig.CellSize * CurrentGridScale;
+	if (ScaledCellSize <= KINDA_SMALL_NUMBER || LocalPosition.X < 0.0f || LocalPosition.Y < 0.0f) return false;
+
+	const int32 Row = FMath::FloorToInt32(LocalPosition.Y / ScaledCellSize);
+	const int32 Column = FMath::FloorToInt32(LocalPosition.X / ScaledCellSize);
+	if (!ItemState->GetOccupancy().IsValidCell(Row, Column)) return false;
+
+	OutRow = Row;
+	OutColumn = Column;
+	return true;
+}
+
+void UOBGridInventoryWidget::GetCellLocalRect(const int32 Row, const int32 Column, FVector2D& OutTopLeft,
+											  FVector2D& OutSize, const int32 RowSpan, const int32 ColumnSpan) const
+{
+	const float ScaledCellSize = GridConfig.CellSize * CurrentGridScale;
+	OutTopLeft = FVector2D(Column * ScaledCellSize, Row * ScaledCellSize);
+	OutSize = FVector2D(FMath::Max(ColumnSpan, 1) * ScaledCellSize, FMath::Max(RowSpan, 1) * ScaledCellSize);
+}
+
+UUserWidget* UOBGridInventoryWidget::GetItemWidgetAtPosition(const FVector2D& AbsolutePosition) const
+{
+	int32 Row = INDEX_NONE;
+	int32 Column = INDEX_NONE;
+	return AbsoluteToCell(AbsolutePosition, Row, Column) ? GetItemWidgetAtCell(Row, Column) : nullptr;
+}
+
+// --- Navigation ---
+
+bool UOBGridInventoryWidget::SetFocusedCell(const int32 Row, const int32 Column)
+{
+	UUserWidget* TargetWidget = ResolveNavigationWidget(Row, Column);
+	if (!TargetWidget) return false;
+
+	FocusedCell = FIntPoint(Column, Row);
+	TargetWidget->SetFocus();
+	return true;
+}
+
+// --- Planning ---
+
+bool UOBGridInventoryWidget::CanFitAll(const TArray<UOBGridInventoryWidget*>& Containers,
+									   const TArray<FOBGridFitRequest>& Items, FOBGridPlacementPlan& OutPlan)
+{
+	// The solver sees each item state once: two views of one state must not both offer its free cells.
+	TArray<int32> StateIndices;
+	TArray<const UOBGridItemState*> States;
+	GatherContainerStates(Containers, StateIndices, States);
+
+	TArray<FOBGridOccupancy> StateOccupancy;
+	StateOccupancy.Reserve(States.Num());
+	for (const UOBGridItemState* State : States)
+	{
+		StateOccupancy.Add(State->GetOccupancy());
+	}
+
+	OutPlan = FOBGridFitSolver::Solve(StateOccupancy, Items);
+	for (FOBGridFitPlacement& Placement : OutPlan.Placements)
+	{
+		// Back to a container index: the first view of that state.
+		Placement.ContainerIndex = StateIndices.IndexOfByKey(Placement.ContainerIndex);
+	}
+
+	// The solver only sees cells; a plan that breaks a capacity rule (weight...) is not feasible either.
+	if (OutPlan.bFeasible && !ValidatePlacementPlan(Containers, Items, OutPlan))
+	{
+		OutPlan.bFeasible = false;
+	}
+	return OutPlan.bFeasible;
+}
+
+bool UOBGridInventoryWidget::CommitPlacementPlan(const TArray<UOBGridInventoryWidget*>& Containers,
+												 const TArray<FOBGridFitRequest>& Items,
+												 const FOBGridPlacementPlan& Plan, TArray<UUserWidget*>& OutItemWidgets)
+{
+	OutItemWidgets.Reset();
+	if (!Plan.bFeasible || Plan.Placements.Num() != Items.Num()) return false;
+
+	// 1. Validate the whole plan against the live state before creating anything.
+	if (!ValidatePlacementPlan(Containers, Items, Plan)) return false;
+
+	// 2. Commit. Roll back if widget creation fails midway.
+	TArray<int32> AddedItemIds;
+	AddedItemIds.Reserve(Plan.Placements.Num());
+	for (const FOBGridFitPlacement& Placement : Plan.Placements)
+	{
+		const FOBGridFitRequest& Item = Items[Placement.RequestIndex];
+		UOBGridInventoryWidget* Container = Containers[Placement.ContainerIndex];
+		const int32 NewItemId = Container->AddItemAt(Item.ItemPayload, Item.ItemRows, Item.ItemCols, Placement.Row,
+													 Placement.Column, Item.CustomItemWidgetClass);
+		if (NewItemId == INDEX_NONE)
+		{
+			for (int32 i = 0; i < AddedItemIds.Num(); ++i)
+			{
+				Containers[Plan.Placements[i].ContainerIndex]->RemoveItem(AddedItemIds[i]);
+			}
+			OutItemWidgets.Reset();
+			return false;
+		}
+		AddedItemIds.Add(NewItemId);
+		// Painted containers only create widgets on demand; their entries stay null.
+		OutItemWidgets.Add(Container->GetItemWidgetById(NewItemId));
+	}
+	return true;
+}
+
+
+bool UOBGridInventoryWidget::ValidatePlacementPlan(const TArray<UOBGridInventoryWidget*>& Containers,
+												   const TArray<FOBGridFitRequest>& Items,
+												   const FOBGridPlacementPlan& Plan)
+{
+	// Views of one item state share its working copy, so two placements cannot claim the same cells through
+	// different views.
+	TArray<int32> StateIndices;
+	TArray<const UOBGridItemState*> States;
+	GatherContainerStates(Containers, StateIndices, States);
+
+	// Aggregates are only projected for states with capacity rules; the others are never copied.
+	TArray<FOBGridOccupancy> Working;
+	TArray<TOptional<FOBGridAggregateSet>> WorkingAggregates;
+	Working.Reserve(States.Num());
+	WorkingAggregates.Reserve(States.Num());
+	for (const UOBGridItemState* State : States)
+	{
+		Working.Add(State->GetOccupancy());
+		WorkingAggregates.Add(State->GetCapacityRules().IsEmpty()
+								  ? TOptional<FOBGridAggregateSet>()
+								  : TOptional<FOBGridAggregateSet>(State->GetAggregates()));
+	}
+
+	// Plans can be edited in Blueprint: each request must be placed exactly once.
+	if (Plan.Placements.Num() != Items.Num()) return false;
+	TBitArray<> PlacedRequests(false, Items.Num());
+
+	for (const FOBGridFitPlacement& Placement : Plan.Placements)
+	{
+		if (!Items.IsValidIndex(Placement.RequestIndex) || !Containers.IsValidIndex(Placement.ContainerIndex))
+		{
+			return false;
+		}
+		if (PlacedRequests[Placement.RequestIndex])
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[%hs] - Request %d is placed twice by the plan; nothing was committed."),
+				   __FUNCTION__, Placement.RequestIndex);
+			return false;
+		}
+		PlacedRequests[Placement.RequestIndex] = true;
+		const FOBGridFitRequest& Item = Items[Placement.RequestIndex];
+		const UOBGridInventoryWidget* Container = Containers[Placement.ContainerIndex];
+		if (!Container || !Container->ValidateAddItemInputs(Item.ItemRows, Item.ItemCols, Item.CustomItemWidgetClass) ||
+			!Working[StateIndices[Placement.ContainerIndex]].IsAreaClear(Placement.Row, Placement.Column,
+																		  Item.ItemRows, Item.ItemCols))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[%hs] - Placement plan is stale for request %d; nothing was committed."),
+				   __FUNCTION__, Placement.RequestIndex);
+			return false;
+		}
+
+		// Running projection: each placement is checked against the ones planned before it in the same state.
+		const int32 StateIndex = StateIndices[Placement.ContainerIndex];
+		if (TOptional<FOBGridAggregateSet>& Projection = WorkingAggregates[StateIndex]; Projection.IsSet())
+		{
+			FName ViolatedRule;
+			if (!Projection->CheckRules(States[StateIndex]->GetCapacityRules(), Item.ItemPayload, FConstStructView(),
+										ViolatedRule))
+			{
+				UE_LOG(LogTemp, Log, TEXT("[%hs] - Request %d is refused by capacity rule '%s' of '%s'."),
+					   __FUNCTION__, Placement.RequestIndex, *ViolatedRule.ToString(), *GetNameSafe(Container));
+				return false;
+			}
+			Projection->AddPayload(Item.ItemPayload);
+		}
+		Working[StateIndex].Fill(Placement.Row, Placement.Column, Item.ItemRows, Item.ItemCols, MAX_int32);
+	}
+	return true;
+}
+
+void UOBGridInventoryWidget::GatherContainerStates(const TArray<UOBGridInventoryWidget*>& Containers,
+												   TArray<int32>& OutStateIndices,
+												   TArray<const UOBGridItemState*>& OutStates)
+{
+	OutStateIndices.Reset(Containers.Num());
+	OutStates.Reset();
+	for (const UOBGridInventoryWidget* Container : Containers)
+	{
+		const UOBGridItemState* State = Container ? Container->GetItemState() : nullptr;
+		OutStateIndices.Add(State ? OutStates.AddUnique(State) : INDEX_NONE);
+	}
+}
+
+// --- Internal Implementation ---
+
+bool UOBGridInventoryWidget::ValidateAddItemInputs(const int32 ItemRows, const int32 ItemCols,
+												   const TSubclassOf<UUserWidget> CustomItemWidgetClass) const
+{
+	if (!ItemGridPanel)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[%s::%hs] - ItemGridPanel is null."), *GetNameSafe(this), __FUNCTION__);
+		return false;
+	}
+	if (!ItemWidgetClass && !CustomItemWidgetClass)
+	{
+		UE_LOG(LogTemp, Error,
+			   TEXT(
+				   "[%s::%hs] - Default ItemWidgetClass is not set, and no CustomItemWidgetClass was provided."
+			   ), *GetNameSafe(this), __FUNCTION__);
+		return false;
+	}
+	if (ItemRows < 1 || ItemCols < 1)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - ItemRows/ItemCols must be at least 1."), *GetNameSafe(this),
+			   __FUNCTION__);
+		return false;
+	}
+	return true;
+}
+
+
+// --- Helpers ---
+
+void UOBGridInventoryWidget::HandleItemStateChanged(UOBGridItemState* ChangedState)
+{
+	if (ChangedState != ItemState) return;
+
+	// Coalesce native notifications: one flush per frame, whatever the number of changes.
+	if (!PendingFlushHandle.IsValid() && !IsDesignTime())
+	{
+		PendingFlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UOBGridInventoryWidget::FlushPendingChanges));
+	}
+
+	if (IsPresentationLive())
+	{
+		ApplyStateChanges();
+	}
+	else
+	{
+		// Off screen: no widget work until the view ticks or is constructed again.
+		bPresentationDirty = true;
+	}
+}
+
+bool UOBGridInventoryWidget::IsPresentationLive() const
+{
+	// Slate only ticks widgets it paints, so a view that missed the last frame is hidden or not in the viewport.
+	return IsDesignTime() || (LastPresentedFrame != 0 && GFrameCounter - LastPresentedFrame <= 1);
+}
+
+void UOBGridInventoryWidget::ApplyChange(const FOBGridChangeRecord& Record)
+{
+	// Events carry copies: listeners may change the state, which can reallocate its item map.
+	switch (Record.Type)
+	{
+	case EOBGridChangeType::Added:
+		if (PresentItem(Record.ItemId))
+		{
+			const FOBGridItemInfo ItemInfo = ItemState->FindItem(Record.ItemId)->WithOwnedPayload();
+			OnItemAdded.Broadcast(GetItemWidgetById(Record.ItemId), ItemInfo);
+		}
+		break;
+	case EOBGridChangeType::Removed:
+		{
+			UUserWidget* RemovedWidget = GetItemWidgetById(Record.ItemId);
+			if (UnpresentItem(Record.ItemId, Record.RowSpan, Record.ColumnSpan))
+			{
+				OnItemRemoved.Broadcast(RemovedWidget);
+			}
+			break;
+		}
+	case EOBGridChangeType::Moved:
+		{
+			const FOBGridItemInfo* FoundInfo = ItemState->FindItem(Record.ItemId);
+			FIntPoint* PresentedCell = PresentedItems.Find(Record.ItemId);
+			if (!FoundInfo || !PresentedCell) break;
+
+			const FOBGridItemInfo ItemInfo = FoundInfo->WithOwnedPayload();
+			const FIntPoint OldCell = *PresentedCell;
+			*PresentedCell = FIntPoint(ItemInfo.Column, ItemInfo.Row);
+			UUserWidget* ItemWidget = GetItemWidgetById(Record.ItemId);
+			SetChildCell(ItemWidget, ItemInfo.Row, ItemInfo.Column);
+			if (UOBGridPanel* PaintingPanel = GetPaintingPanel())
+			{
+				PaintingPanel->SetPaintedItemCell(Record.ItemId, ItemInfo.Row, ItemInfo.Column);
+			}
+			RefreshDummyCellsInArea(OldCell.Y, OldCell.X, ItemInfo.RowSpan, ItemInfo.ColumnSpan);
+			RefreshDummyCellsInArea(ItemInfo.Row, ItemInfo.Column, ItemInfo.RowSpan, ItemInfo.ColumnSpan);
+			OnItemMoved.Broadcast(ItemWidget, ItemInfo);
+			break;
+		}
+	case EOBGridChangeType::PayloadChanged:
+		{
+			const FOBGridItemInfo* FoundInfo = ItemState->FindItem(Record.ItemId);
+			if (!FoundInfo || !PresentedItems.Contains(Record.ItemId)) break;
+
+			const FOBGridItemInfo ItemInfo = FoundInfo->WithOwnedPayload();
+			UUserWidget* ItemWidget = GetItemWidgetById(Record.ItemId);
+			if (ItemWidget && ItemWidget->Implements<UOBGridItemWidgetInterface>())
+			{
+				IOBGridItemWidgetInterface::Execute_OnItemPayloadChanged(ItemWidget, ItemInfo);
+			}
+			if (UOBGridPanel* PaintingPanel = GetPaintingPanel())
+			{
+				PaintingPanel->SetPaintedItem(Record.ItemId, MakePaintedItem(ItemInfo));
+			}
+			OnItemPayloadChanged.Broadcast(ItemWidget, ItemInfo);
+			break;
+		}
+	case EOBGridChangeType::Reset:
+		ReconcilePresentation();
+		break;
+	case EOBGridChangeType::LayoutChanged:
+		ApplyStateLayout();
+		break;
+	case EOBGridChangeType::PendingChanged:
+		{
+			// The held cells were freed or taken; the item itself may be gone already.
+			RefreshDummyCellsInArea(Record.Row, Record.Column, Record.RowSpan, Record.ColumnSpan);
+			const FOBGridItemInfo* FoundInfo = ItemState->FindItem(Record.ItemId);
+			if (!FoundInfo || !PresentedItems.Contains(Record.ItemId)) break;
+
+			const FOBGridItemInfo ItemInfo = FoundInfo->WithOwnedPayload();
+			const bool bPending = ItemState->IsItemPending(Record.ItemId);
+			UUserWidget* ItemWidget = GetItemWidgetById(Record.ItemId);
+			if (ItemWidget && ItemWidget->Implements<UOBGridItemWidgetInterface>())
+			{
+				IOBGridItemWidgetInterface::Execute_OnItemPendingChanged(ItemWidget, ItemInfo, bPending);
+			}
+			OnItemPendingChanged.Broadcast(ItemWidget, ItemInfo, bPending);
+			break;
+		}
+	}
+}
+
+bool UOBGridInventoryWidget::PresentItem(const int32 ItemId)
+{
+	const FOBGridItemInfo* ItemInfo = ItemState->FindItem(ItemId);
+	if (!ItemInfo || PresentedItems.Contains(ItemId)) return false;
+
+	const int32 Row = ItemInfo->Row;
+	const int32 Column = ItemInfo->Column;
+	const int32 RowSpan = ItemInfo->RowSpan;
+	const int32 ColumnSpan = ItemInfo->ColumnSpan;
+	PresentedItems.Add(ItemId, FIntPoint(Column, Row));
+	if (UOBGridPanel* PaintingPanel = GetPaintingPanel())
+	{
+		PaintingPanel->SetPaintedItem(ItemId, MakePaintedItem(*ItemInfo));
+	}
+	else if (!GetItemWidgetById(ItemId) && !CreateItemWidgetFor(ItemId))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - No widget could be created for item %d."), *GetNameSafe(this),
+			   __FUNCTION__, ItemId);
+	}
+	RefreshDummyCellsInArea(Row, Column, RowSpan, ColumnSpan);
+	return true;
+}
+
+bool UOBGridInventoryWidget::UnpresentItem(const int32 ItemId, const int32 RowSpan, const int32 ColumnSpan)
+{
+	FIntPoint PresentedCell;
+	const bool bWasPresented = PresentedItems.RemoveAndCopyValue(ItemId, PresentedCell);
+
+	if (HoveredItemId == ItemId) HoveredItemId = INDEX_NONE;
+	if (FocusedItemId == ItemId) FocusedItemId = INDEX_NONE;
+	// Listeners receive the widget, so it must not be handed to another item through the pool.
+	DestroyItemWidgetFor(ItemId, false);
+	if (UOBGridPanel* PaintingPanel = GetPaintingPanel())
+	{
+		PaintingPanel->RemovePaintedItem(ItemId);
+	}
+	if (bWasPresented)
+	{
+		RefreshDummyCellsInArea(PresentedCell.Y, PresentedCell.X, RowSpan, ColumnSpan);
+	}
+	return bWasPresented;
+}
+
+void UOBGridInventoryWidget::ReconcileConfigWithState()
+{
+	// Copied: applying a resize syncs GridConfig back from the state.
+	const FOBGridInventoryConfig WantedConfig = GridConfig;
+	if (ItemState->GetNumRows() != WantedConfig.NumRows || ItemState->GetNumColumns() != WantedConfig.NumColumns)
+	{
+		// Nobody asked for items to leave the grid here, so never let DefaultResizePolicy overflow them.
+		if (!ResizeGrid(WantedConfig.NumRows, WantedConfig.NumColumns, EOBGridResizePolicy::Reject))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - GridConfig asks for %dx%d; kept %dx%d to keep every item."),
+				   *GetNameSafe(this), __FUNCTION__, WantedConfig.NumRows, WantedConfig.NumColumns,
+				   ItemState->GetNumRows(), ItemState->GetNumColumns());
+		}
+	}
+	if (ItemState->GetSections() != WantedConfig.Sections ||
+		ItemState->GetDisabledCells() != WantedConfig.DisabledCells)
+	{
+		if (!SetGridLayout(WantedConfig.Sections, WantedConfig.DisabledCells))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - GridConfig layout refused; kept the current one."),
+				   *GetNameSafe(this), __FUNCTION__);
+		}
+	}
+
+	// Whatever was refused, GridConfig describes the state again.
+	GridConfig.NumRows = ItemState->GetNumRows();
+	GridConfig.NumColumns = ItemState->GetNumColumns();
+	GridConfig.Sections = ItemState->GetSections();
+	GridConfig.DisabledCells = ItemState->GetDisabledCells();
+}
+
+FIntPoint UOBGridInventoryWidget::SyncLayoutFromState()
+{
+	const FIntPoint OldGridSize = PresentedGridSize;
+	GridConfig.NumRows = ItemState->GetNumRows();
+	GridConfig.NumColumns = ItemState->GetNumColumns();
+	GridConfig.Sections = ItemState->GetSections();
+	GridConfig.DisabledCells = ItemState->GetDisabledCells();
+	PresentedGridSize = FIntPoint(GridConfig.NumColumns, GridConfig.NumRows);
+	SetTrackFills(OldGridSize.Y, OldGridSize.X, PresentedGridSize.Y, PresentedGridSize.X);
+	return OldGridSize;
 }
 
-// --- Item Management ---
-
-UUserWidget* UOBGridInventoryWidget::AddItemWidget(const FInstancedStruct& ItemPayload, const int32 ItemRows,
-												   const int32 ItemCols,
-												   const TSubclassOf<UUserWidget> CustomItemWidgetClass)
+void UOBGridInventoryWidget::ApplyStateLayout()
 {
-	if (!ValidateAddItemInputs(ItemRows, ItemCols, CustomItemWidgetClass))
+	const FIntPoint OldGridSize = SyncLayoutFromState();
+	if (OldGridSize == PresentedGridSize)
 	{
-		return nullptr;
+		// Same size: the sections or the cell mask changed.
+		UpdateDummyCells();
 	}
-
-	int32 FoundRow = -1;
-	int32 FoundCol = -1;
-	if (!FindFreeSlot(ItemRows, ItemCols, FoundRow, FoundCol))
+	else
 	{
-		UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - No available space found for item size %dx%d."), *GetNameSafe(this),
-			   __FUNCTION__, ItemRows, ItemCols);
-		return nullptr;
+		// Only the rows/columns that were added or removed need their dummy cells touched.
+		TArray<FIntPoint> DummiesOutOfBounds;
+		for (const TPair<FIntPoint, TWeakObjectPtr<UUserWidget>>& Pair : DummyCellWidgetsMap)
+		{
+			if (Pair.Key.X >= PresentedGridSize.X || Pair.Key.Y >= PresentedGridSize.Y)
+			{
+				DummiesOutOfBounds.Add(Pair.Key);
+			}
+		}
+		for (const FIntPoint& Coord : DummiesOutOfBounds)
+		{
+			RemoveDummyWidgetAt(Coord);
+		}
+		RefreshDummyCellsInArea(OldGridSize.Y, 0, PresentedGridSize.Y - OldGridSize.Y, PresentedGridSize.X);
+		RefreshDummyCellsInArea(0, OldGridSize.X, FMath::Min(OldGridSize.Y, PresentedGridSize.Y),
+								PresentedGridSize.X - OldGridSize.X);
 	}
 
-	return AddItemWidgetInternal(ItemPayload, ItemRows, ItemCols, FoundRow, FoundCol,
-								 CustomItemWidgetClass);
+	UpdateGridBackground();
+	// Force the next tick to recompute the scale for the new aspect ratio.
+	LastKnownAllocatedSize = FVector2D(-1.0f, -1.0f);
+	UpdateSizeBoxOverride();
 }
 
-UUserWidget* UOBGridInventoryWidget::AddItemWidgetAt(const FInstancedStruct& ItemPayload, const int32 ItemRows,
-													 const int32 ItemCols,
-													 const int32 RowTopLeft, const int32 ColTopLeft,
-													 const TSubclassOf<UUserWidget> CustomItemWidgetClass)
+void UOBGridInventoryWidget::RebuildPresentation()
 {
-	if (!ValidateAddItemInputs(ItemRows, ItemCols, CustomItemWidgetClass))
+	AppliedSequence = ItemState->GetChangeJournal().GetLatestSequence();
+	bPresentationDirty = false;
+	if (!ItemGridPanel) return;
+
+	ItemGridPanel->ClearChildren();
+	if (UOBGridPanel* CellGridPanel = Cast<UOBGridPanel>(ItemGridPanel))
 	{
-		return nullptr;
+		CellGridPanel->ClearPaintedItems();
 	}
+	PresentedItems.Empty();
+	DummyCellWidgetsMap.Empty();
+	DummyCellsByWidget.Empty();
+	ItemWidgetsById.Empty();
+	ItemIdsByWidget.Empty();
+	WidgetDemandsById.Empty();
+	HoveredItemId = INDEX_NONE;
+	FocusedItemId = INDEX_NONE;
 
-	if (!IsAreaClear(RowTopLeft, ColTopLeft, ItemRows, ItemCols))
+	SyncLayoutFromState();
+	TArray<int32> AllItemIds;
+	GetAllItemIds(AllItemIds);
+	for (const int32 ItemId : AllItemIds)
 	{
-		UE_LOG(LogTemp, Warning,
-			   TEXT("[%s::%hs] - Failed to add item. Target area at [%d, %d] with size [%d, %d] is not clear."),
-			   *GetNameSafe(this), __FUNCTION__, RowTopLeft, ColTopLeft, ItemRows, ItemCols);
-		return nullptr;
+		PresentItem(ItemId);
 	}
+	UpdateDummyCells();
 
-	return AddItemWidgetInternal(ItemPayload, ItemRows, ItemCols, RowTopLeft, ColTopLeft,
-								 CustomItemWidgetClass);
+	UpdateGridBackground();
+	LastKnownAllocatedSize = FVector2D(-1.0f, -1.0f);
+	UpdateSizeBoxOverride();
 }
 
-bool UOBGridInventoryWidget::RemoveItemWidget(UUserWidget* ItemWidgetToRemove)
+void UOBGridInventoryWidget::ReconcilePresentation()
 {
-	if (!ItemWidgetToRemove || !ItemGridPanel) return false;
+	AppliedSequence = ItemState->GetChangeJournal().GetLatestSequence();
+	bPresentationDirty = false;
+	if (!ItemGridPanel) return;
 
-	if (const int32 NumRemovedFromMap = PlacedItemInfoMap.Remove(ItemWidgetToRemove); NumRemovedFromMap > 0)
+	// Item ids are never reused, so an id presented here and still in the state is the same item. Widgets of
+	// surviving items are kept; every difference goes through the same events as a journal record would.
+	SyncLayoutFromState();
+	TArray<int32> GoneItemIds;
+	for (const TPair<int32, FIntPoint>& Pair : PresentedItems)
 	{
-		ItemGridPanel->RemoveChild(ItemWidgetToRemove);
-		UpdateDummyCells();
-		OnItemRemoved.Broadcast(ItemWidgetToRemove);
-		return true;
+		if (!ItemState->FindItem(Pair.Key))
+		{
+			GoneItemIds.Add(Pair.Key);
+		}
+	}
+	for (const int32 ItemId : GoneItemIds)
+	{
+		// The spans of a removed item are gone too; the dummy cells are refreshed once below instead.
+		UUserWidget* RemovedWidget = GetItemWidgetById(ItemId);
+		if (UnpresentItem(ItemId, 0, 0))
+		{
+			OnItemRemoved.Broadcast(RemovedWidget);
+		}
 	}
-	return false;
-}
 
-void UOBGridInventoryWidget::ClearGrid()
-{
-	if (!ItemGridPanel) return;
-	TArray<UUserWidget*> AllWidgets;
-	GetAllItemWidgets(AllWidgets);
-	for (UUserWidget* Widget : AllWidgets)
+	TArray<int32> AllItemIds;
+	GetAllItemIds(AllItemIds);
+	for (const int32 ItemId : AllItemIds)
 	{
-		RemoveItemWidget(Widget);
+		const FOBGridItemInfo* FoundInfo = ItemState->FindItem(ItemId);
+		if (!FoundInfo) continue;
+
+		const FOBGridItemInfo ItemInfo = FoundInfo->WithOwnedPayload();
+		const FIntPoint* PresentedCell = PresentedItems.Find(ItemId);
+		if (!PresentedCell)
+		{
+			if (PresentItem(ItemId))
+			{
+				OnItemAdded.Broadcast(GetItemWidgetById(ItemId), ItemInfo);
+			}
+			continue;
+		}
+
+		UUserWidget* ItemWidget = GetItemWidgetById(ItemId);
+		if (*PresentedCell != FIntPoint(ItemInfo.Column, ItemInfo.Row))
+		{
+			PresentedItems.Add(ItemId, FIntPoint(ItemInfo.Column, ItemInfo.Row));
+			SetChildCell(ItemWidget, ItemInfo.Row, ItemInfo.Column);
+			if (UOBGridPanel* PaintingPanel = GetPaintingPanel())
+			{
+				PaintingPanel->SetPaintedItemCell(ItemId, ItemInfo.Row, ItemInfo.Column);
+			}
+			OnItemMoved.Broadcast(ItemWidget, ItemInfo);
+		}
+
+		// Whether the payload or the pending flag changed in between is unknown, so both are refreshed.
+		const bool bPending = ItemState->IsItemPending(ItemId);
+		if (ItemWidget && ItemWidget->Implements<UOBGridItemWidgetInterface>())
+		{
+			IOBGridItemWidgetInterface::Execute_OnItemPayloadChanged(ItemWidget, ItemInfo);
+			IOBGridItemWidgetInterface::Execute_OnItemPendingChanged(ItemWidget, ItemInfo, bPending);
+		}
+		if (UOBGridPanel* PaintingPanel = GetPaintingPanel())
+		{
+			PaintingPanel->SetPaintedItem(ItemId, MakePaintedItem(ItemInfo));
+		}
+		OnItemPayloadChanged.Broadcast(ItemWidget, ItemInfo);
+		OnItemPendingChanged.Broadcast(ItemWidget, ItemInfo, bPending);
 	}
 	UpdateDummyCells();
-	UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Grid cleared of all items."), *GetNameSafe(this), __FUNCTION__);
+
+	UpdateGridBackground();
+	LastKnownAllocatedSize = FVector2D(-1.0f, -1.0f);
+	UpdateSizeBoxOverride();
 }
 
-bool UOBGridInventoryWidget::MoveItemWidget(UUserWidget* ItemWidgetToMove, const int32 NewRowTopLeft,
-											const int32 NewColTopLeft)
+UUserWidget* UOBGridInventoryWidget::CreateItemWidgetFor(const int32 ItemId)
 {
-	if (!ItemWidgetToMove || !ItemGridPanel) return false;
-	FOBGridItemInfo* ItemInfo = PlacedItemInfoMap.Find(ItemWidgetToMove);
-	if (!ItemInfo) return false;
+	const FOBGridItemInfo* ItemInfo = ItemState->FindItem(ItemId);
+	if (!ItemInfo) return nullptr;
+
+	const TSubclassOf<UUserWidget> CustomClass = ItemState->GetItemWidgetClass(ItemId);
+	const TSubclassOf<UUserWidget> WidgetClassToCreate = CustomClass ? CustomClass : ItemWidgetClass;
+	if (!WidgetClassToCreate) return nullptr;
 
-	if (!IsAreaClearForMove(NewRowTopLeft, NewColTopLeft, ItemInfo->RowSpan, ItemInfo->ColumnSpan, ItemWidgetToMove))
+	// Painted mode hands widgets from item to item as the hover moves; reuse one of the right class if possible.
+	UUserWidget* NewItemWidget = nullptr;
+	const int32 PooledIndex = PooledItemWidgets.IndexOfByPredicate(
+		[&WidgetClassToCreate](const TObjectPtr<UUserWidget>& PooledWidget)
+		{
+			return PooledWidget && PooledWidget->GetClass() == WidgetClassToCreate.Get();
+		});
+	if (PooledIndex != INDEX_NONE)
 	{
-		return false;
+		NewItemWidget = PooledItemWidgets[PooledIndex];
+		PooledItemWidgets.RemoveAtSwap(PooledIndex);
+	}
+	else
+	{
+		NewItemWidget = CreateWidget<UUserWidget>(this, WidgetClassToCreate);
+	}
+	if (!NewItemWidget || !AddChildToCell(NewItemWidget, ItemInfo->Row, ItemInfo->Column, ItemInfo->RowSpan,
+										   ItemInfo->ColumnSpan))
+	{
+		return nullptr;
 	}
 
-	ItemInfo->Row = NewRowTopLeft;
-	ItemInfo->Column = NewColTopLeft;
+	ItemWidgetsById.Add(ItemId, NewItemWidget);
+	ItemIdsByWidget.Add(NewItemWidget, ItemId);
 
-	if (UGridSlot* GridSlot = Cast<UGridSlot>(ItemWidgetToMove->Slot))
+	// Check if the newly created widget implements our interface.
+	if (NewItemWidget->Implements<UOBGridItemWidgetInterface>())
 	{
-		GridSlot->SetRow(NewRowTopLeft);
-		GridSlot->SetColumn(NewColTopLeft);
-		UpdateDummyCells();
-		OnItemMoved.Broadcast(ItemWidgetToMove, *ItemInfo);
-		return true;
+		// Call the interface function to pass the data to the widget.
+		IOBGridItemWidgetInterface::Execute_OnItemInitialized(NewItemWidget, ItemInfo->WithOwnedPayload());
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning,
+			   TEXT(
+				   "[%s::%hs] - Widget '%s' of class '%s' was added to the grid but does not implement IOBGridItemWidgetInterface. It will not receive its item data."
+			   ),
+			   *GetNameSafe(this), __FUNCTION__, *GetNameSafe(NewItemWidget), *GetNameSafe(WidgetClassToCreate));
 	}
-	return false;
-}
-
-// --- Querying ---
 
-bool UOBGridInventoryWidget::IsAreaClear(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows,
-										 const int32 ItemCols) const
-{
-	const FIntRect NewItemRect(TopLeftCol, TopLeftRow, TopLeftCol + ItemCols, TopLeftRow + ItemRows);
-	for (const TPair<TObjectPtr<UUserWidget>, FOBGridItemInfo>& Pair : PlacedItemInfoMap)
+	if (UOBGridPanel* PaintingPanel = GetPaintingPanel())
 	{
-		if (!Pair.Key) continue;
-		const FOBGridItemInfo& ExistingInfo = Pair.Value;
-		const FIntRect ExistingItemRect(ExistingInfo.Column, ExistingInfo.Row,
-										ExistingInfo.Column + ExistingInfo.ColumnSpan,
-										ExistingInfo.Row + ExistingInfo.RowSpan);
-		if (NewItemRect.Intersect(ExistingItemRect))
-		{
-			return false;
-		}
+		PaintingPanel->SetPaintedItemHidden(ItemId, true);
 	}
-	return true;
+	return NewItemWidget;
 }
 
-void UOBGridInventoryWidget::GetAllItemWidgets(TArray<UUserWidget*>& OutItemWidgets) const
+void UOBGridInventoryWidget::DestroyItemWidgetFor(const int32 ItemId, const bool bReturnToPool)
 {
-	OutItemWidgets.Empty();
-	for (const auto& Pair : PlacedItemInfoMap)
+	WidgetDemandsById.Remove(ItemId);
+	TObjectPtr<UUserWidget> ItemWidget;
+	if (!ItemWidgetsById.RemoveAndCopyValue(ItemId, ItemWidget)) return;
+
+	ItemIdsByWidget.Remove(ItemWidget);
+	if (ItemWidget && ItemGridPanel)
 	{
-		if (Pair.Key)
+		ItemGridPanel->RemoveChild(ItemWidget);
+	}
+	if (UOBGridPanel* PaintingPanel = GetPaintingPanel())
+	{
+		PaintingPanel->SetPaintedItemHidden(ItemId, false);
+		if (bReturnToPool && ItemWidget && PooledItemWidgets.Num() < MaxPooledItemWidgets)
 		{
-			OutItemWidgets.Add(Pair.Key);
+			PooledItemWidgets.Add(ItemWidget);
 		}
 	}
 }
 
-bool UOBGridInventoryWidget::GetItemInfo(UUserWidget* ItemWidget, FOBGridItemInfo& OutItemInfo) const
+UOBGridPanel* UOBGridInventoryWidget::GetPaintingPanel() const
 {
-	if (!ItemWidget) return false;
-	if (const FOBGridItemInfo* FoundInfo = PlacedItemInfoMap.Find(ItemWidget))
-	{
-		OutItemInfo = *FoundInfo;
-		return true;
-	}
-	return false;
+	return bUsePaintedItems ? Cast<UOBGridPanel>(ItemGridPanel) : nullptr;
 }
 
-bool UOBGridInventoryWidget::GetItemAt(const int32 TopLeftRow, const int32 TopLeftCol,
-									   UUserWidget*& OutItemWidget, FInstancedStruct& OutItemPayload) const
+FOBGridPaintedItem UOBGridInventoryWidget::MakePaintedItem(const FOBGridItemInfo& ItemInfo) const
 {
-	OutItemWidget = nullptr;
-	OutItemPayload.Reset();
+	FOBGridPaintedItem PaintedItem;
+	PaintedItem.Row = ItemInfo.Row;
+	PaintedItem.Column = ItemInfo.Column;
+	PaintedItem.RowSpan = ItemInfo.RowSpan;
+	PaintedItem.ColumnSpan = ItemInfo.ColumnSpan;
+	PaintedItem.bHidden = ItemWidgetsById.Contains(ItemInfo.ItemId);
 
-	for (const TPair<TObjectPtr<UUserWidget>, FOBGridItemInfo>& Pair : PlacedItemInfoMap)
+	// Blueprint overrides read ItemPayload, which interned items leave empty; the native default does not.
+	static const FName ResolveItemVisualName = GET_FUNCTION_NAME_CHECKED(UOBGridInventoryWidget, ResolveItemVisual);
+	if (ItemInfo.SharedPayload.IsValid() && GetClass()->IsFunctionImplementedInScript(ResolveItemVisualName))
 	{
-		if (const FOBGridItemInfo& Info = Pair.Value; Info.Row == TopLeftRow && Info.Column == TopLeftCol)
-		{
-			OutItemWidget = Pair.Key;
-			OutItemPayload = Info.ItemPayload;
-			return true;
-		}
+		ResolveItemVisual(ItemInfo.WithOwnedPayload(), PaintedItem.Visual);
 	}
-	return false;
+	else
+	{
+		ResolveItemVisual(ItemInfo, PaintedItem.Visual);
+	}
+	return PaintedItem;
 }
 
-bool UOBGridInventoryWidget::GetItemPayload(UUserWidget* ItemWidget, FInstancedStruct& OutItemPayload) const
+void UOBGridInventoryWidget::SetHoveredItem(const int32 ItemId)
 {
-	OutItemPayload.Reset();
-	if (!ItemWidget) return false;
-
-	if (const FOBGridItemInfo* FoundInfo = PlacedItemInfoMap.Find(ItemWidget))
+	if (HoveredItemId == ItemId) return;
+	// Release first so the outgoing widget can be reused straight away for the incoming item.
+	const int32 PreviousItemId = HoveredItemId;
+	HoveredItemId = ItemId;
+	if (PreviousItemId != INDEX_NONE)
 	{
-		OutItemPayload = FoundInfo->ItemPayload;
-		return true;
+		ReleaseItemWidget(PreviousItemId, EOBGridItemWidgetDemand::Hover);
+	}
+	if (ItemId != INDEX_NONE)
+	{
+		AcquireItemWidget(ItemId, EOBGridItemWidgetDemand::Hover);
 	}
-	return false;
 }
 
-
-// --- Internal Implementation ---
-
-bool UOBGridInventoryWidget::ValidateAddItemInputs(const int32 ItemRows, const int32 ItemCols,
-												   const TSubclassOf<UUserWidget> CustomItemWidgetClass) const
+void UOBGridInventoryWidget::SetFocusedItem(const int32 ItemId)
 {
-	if (!ItemGridPanel)
+	if (FocusedItemId == ItemId) return;
+	const int32 PreviousItemId = FocusedItemId;
+	FocusedItemId = ItemId;
+	if (PreviousItemId != INDEX_NONE)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s::%hs] - ItemGridPanel is null."), *GetNameSafe(this), __FUNCTION__);
-		return false;
+		ReleaseItemWidget(PreviousItemId, EOBGridItemWidgetDemand::Focus);
 	}
-	if (!ItemWidgetClass && !CustomItemWidgetClass)
+	if (ItemId != INDEX_NONE)
 	{
-		UE_LOG(LogTemp, Error,
-			   TEXT(
-				   "[%s::%hs] - Default ItemWidgetClass is not set, and no CustomItemWidgetClass was provided."
-			   ), *GetNameSafe(this), __FUNCTION__);
-		return false;
+		AcquireItemWidget(ItemId, EOBGridItemWidgetDemand::Focus);
 	}
-	if (ItemRows < 1 || ItemCols < 1)
+}
+
+UUserWidget* UOBGridInventoryWidget::ResolveNavigationWidget(const int32 Row, const int32 Column)
+{
+	if (!ItemState->GetOccupancy().IsCellEnabled(Row, Column)) return nullptr;
+	if (const int32 ItemId = GetItemIdAtCell(Row, Column); ItemId != INDEX_NONE)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - ItemRows/ItemCols must be at least 1."), *GetNameSafe(this),
-			   __FUNCTION__);
-		return false;
+		// In painted mode this materializes the item's widget for as long as it keeps the focus.
+		SetFocusedItem(ItemId);
+		return GetItemWidgetById(ItemId);
 	}
-	return true;
+	if (const TWeakObjectPtr<UUserWidget>* DummyWidget = DummyCellWidgetsMap.Find(FIntPoint(Column, Row)))
+	{
+		SetFocusedItem(INDEX_NONE);
+		return DummyWidget->Get();
+	}
+	return nullptr;
 }
 
-UUserWidget* UOBGridInventoryWidget::AddItemWidgetInternal(const FInstancedStruct& ItemPayload, const int32 ItemRows,
-														   const int32 ItemCols, const int32 RowTopLeft,
-														   const int32 ColTopLeft,
-														   const TSubclassOf<UUserWidget> CustomItemWidgetClass)
+bool UOBGridInventoryWidget::FindUserFocusedCell(const uint32 UserIndex, FIntPoint& OutCell) const
 {
-	const TSubclassOf<UUserWidget> WidgetClassToCreate =
-		CustomItemWidgetClass ? CustomItemWidgetClass : ItemWidgetClass;
-	if (!WidgetClassToCreate) return nullptr;
-
-	UUserWidget* NewItemWidget = CreateWidget<UUserWidget>(this, WidgetClassToCreate);
-	if (!NewItemWidget) return nullptr;
+	const TSharedPtr<SWidget> GridWidget = GetCachedWidget();
+	if (!GridWidget || !FSlateApplication::IsInitialized()) return false;
 
-	if (UGridSlot* GridSlot = ItemGridPanel->AddChildToGrid(NewItemWidget, RowTopLeft, ColTopLeft))
+	// The focus may sit on a child of an item or dummy widget (a button inside it): walk up to the first item or
+	// dummy, so the cost is the depth of the focus chain rather than the number of cells. Lookups go through the
+	// UUserWidget, since its Slate widget is rebuilt whenever the grid's Slate resources are released.
+	static const FName ObjectWidgetType(TEXT("SObjectWidget"));
+	for (TSharedPtr<SWidget> Widget = FSlateApplication::Get().GetUserFocusedWidget(UserIndex); Widget.IsValid();
+		 Widget = Widget->GetParentWidget())
 	{
-		GridSlot->SetRowSpan(ItemRows);
-		GridSlot->SetColumnSpan(ItemCols);
-		GridSlot->SetHorizontalAlignment(HAlign_Fill);
-		GridSlot->SetVerticalAlignment(VAlign_Fill);
+		if (Widget == GridWidget) return false;
+		if (Widget->GetType() != ObjectWidgetType) continue;
 
-		const FOBGridItemInfo NewItemInfo(RowTopLeft, ColTopLeft, ItemRows, ItemCols, ItemPayload);
-		PlacedItemInfoMap.Add(NewItemWidget, NewItemInfo);
-
-		// Check if the newly created widget implements our interface.
-		if (NewItemWidget->Implements<UOBGridItemWidgetInterface>())
+		UUserWidget* UserWidget = StaticCastSharedPtr<SObjectWidget>(Widget)->GetWidgetObject();
+		if (const int32* ItemId = ItemIdsByWidget.Find(UserWidget))
 		{
-			// Call the interface function to pass the data to the widget.
-			IOBGridItemWidgetInterface::Execute_OnItemInitialized(NewItemWidget, NewItemInfo);
+			const FOBGridItemInfo* Info = ItemState->FindItem(*ItemId);
+			if (!Info) return false;
+			// Keep the remembered cell while it is on that item, so crossing a large item keeps its row or column.
+			OutCell = Info->ContainsCell(OutCell.Y, OutCell.X) ? OutCell : FIntPoint(Info->Column, Info->Row);
+			return true;
 		}
-		else
+		if (const FIntPoint* DummyCell = DummyCellsByWidget.Find(UserWidget))
 		{
-			UE_LOG(LogTemp, Warning,
-				   TEXT(
-					   "[%s::%hs] - Widget '%s' of class '%s' was added to the grid but does not implement IOBGridItemWidgetInterface. It will not receive its item data."
-				   ),
-				   *GetNameSafe(this), __FUNCTION__, *GetNameSafe(NewItemWidget), *GetNameSafe(WidgetClassToCreate));
+			OutCell = *DummyCell;
+			return true;
 		}
-
-		UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Added '%s' at (Row:%d, Col:%d), Span(Rows:%d, Cols:%d)"),
-			   *GetNameSafe(this), __FUNCTION__, *NewItemWidget->GetName(), RowTopLeft, ColTopLeft, ItemRows, ItemCols);
-
-		UpdateDummyCells();
-		OnItemAdded.Broadcast(NewItemWidget, NewItemInfo);
-		return NewItemWidget;
 	}
-
-	return nullptr;
+	return false;
 }
 
+bool UOBGridInventoryWidget::FindNavigationTarget(const EUINavigation Direction, FIntPoint& InOutCell,
+												  bool& bOutEscaped) const
+{
+	bOutEscaped = false;
+	const FOBGridOccupancy& Occupancy = ItemState->GetOccupancy();
+	const int32 NumRows = Occupancy.GetNumRows();
+	const int32 NumColumns = Occupancy.GetNumColumns();
+	if (NumRows <= 0 || NumColumns <= 0) return false;
 
-// --- Helpers ---
+	FIntPoint Step = FIntPoint::ZeroValue;
+	switch (Direction)
+	{
+	case EUINavigation::Left: Step.X = -1;
+		break;
+	case EUINavigation::Right: Step.X = 1;
+		break;
+	case EUINavigation::Up: Step.Y = -1;
+		break;
+	case EUINavigation::Down: Step.Y = 1;
+		break;
+	default: return false;
+	}
 
-bool UOBGridInventoryWidget::FindFreeSlot(const int32 ItemRows, const int32 ItemCols,
-										  int32& OutRow, int32& OutCol) const
-{
-	if (GridConfig.NumRows < ItemRows || GridConfig.NumColumns < ItemCols) return false;
+	FIntPoint Cell(FMath::Clamp(InOutCell.X, 0, NumColumns - 1), FMath::Clamp(InOutCell.Y, 0, NumRows - 1));
+
+	// Leave the current item through its far edge, so multi-cell items are crossed in one step.
+	const int32 CurrentItemId = GetItemIdAtCell(Cell.Y, Cell.X);
+	if (const FOBGridItemInfo* CurrentInfo = ItemState->FindItem(CurrentItemId))
+	{
+		if (Step.X > 0) Cell.X = CurrentInfo->Column + CurrentInfo->ColumnSpan - 1;
+		if (Step.X < 0) Cell.X = CurrentInfo->Column;
+		if (Step.Y > 0) Cell.Y = CurrentInfo->Row + CurrentInfo->RowSpan - 1;
+		if (Step.Y < 0) Cell.Y = CurrentInfo->Row;
+	}
 
-	for (int32 TestRow = 0; TestRow <= GridConfig.NumRows - ItemRows; ++TestRow)
+	// Walk at most one lane length; with wrapping that visits each cell of the lane once, so the cost stays bounded
+	// by the lane length in every edge mode.
+	const int32 LaneLength = Step.X != 0 ? NumColumns : NumRows;
+	for (int32 Steps = 0; Steps < LaneLength; ++Steps)
 	{
-		for (int32 TestCol = 0; TestCol <= GridConfig.NumColumns - ItemCols; ++TestCol)
+		Cell += Step;
+		if (Cell.X < 0 || Cell.X >= NumColumns || Cell.Y < 0 || Cell.Y >= NumRows)
 		{
-			if (IsAreaClear(TestRow, TestCol, ItemRows, ItemCols))
+			if (NavigationEdgeBehavior == EOBGridNavigationEdge::Escape)
 			{
-				OutRow = TestRow;
-				OutCol = TestCol;
-				return true;
+				bOutEscaped = true;
+				return false;
 			}
+			if (NavigationEdgeBehavior == EOBGridNavigationEdge::Stop) return false;
+
+			Cell.X = (Cell.X + NumColumns) % NumColumns;
+			Cell.Y = (Cell.Y + NumRows) % NumRows;
 		}
-	}
-	return false;
-}
 
-bool UOBGridInventoryWidget::IsAreaClearForMove(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows,
-												const int32 ItemCols, UUserWidget* IgnoredWidget) const
-{
-	const FIntRect NewItemRect(TopLeftCol, TopLeftRow, TopLeftCol + ItemCols, TopLeftRow + ItemRows);
-	for (const TPair<TObjectPtr<UUserWidget>, FOBGridItemInfo>& Pair : PlacedItemInfoMap)
-	{
-		if (!Pair.Key || Pair.Key == IgnoredWidget) continue;
-		const FOBGridItemInfo& ExistingInfo = Pair.Value;
-		const FIntRect ExistingItemRect(ExistingInfo.Column, ExistingInfo.Row,
-										ExistingInfo.Column + ExistingInfo.ColumnSpan,
-										ExistingInfo.Row + ExistingInfo.RowSpan);
-		if (NewItemRect.Intersect(ExistingItemRect))
+		const int32 CandidateItemId = GetItemIdAtCell(Cell.Y, Cell.X);
+		if (CandidateItemId != INDEX_NONE && CandidateItemId != CurrentItemId)
 		{
-			return false;
+			InOutCell = Cell;
+			return true;
+		}
+		if (CandidateItemId == INDEX_NONE && bNavigateEmptyCells && Occupancy.IsCellEnabled(Cell.Y, Cell.X))
+		{
+			if (const TWeakObjectPtr<UUserWidget>* DummyWidget = DummyCellWidgetsMap.Find(Cell);
+				DummyWidget && DummyWidget->IsValid())
+			{
+				InOutCell = Cell;
+				return true;
+			}
 		}
 	}
-	return true;
+	return false;
 }
 
 void UOBGridInventoryWidget::UpdateGridBackground() const
@@ -382,6 +1526,10 @@ void UOBGridInventoryWidget::UpdateGridBackground() const
 	{
 		GridBackground->UpdateGridParameters(GridConfig);
 	}
+	if (UOBGridPanel* CellGridPanel = Cast<UOBGridPanel>(ItemGridPanel))
+	{
+		CellGridPanel->SetGridConfig(GridConfig);
+	}
 }
 
 bool UOBGridInventoryWidget::CalculateCurrentScale(const FGeometry& CurrentGeometry)
@@ -419,7 +1567,12 @@ void UOBGridInventoryWidget::RecalculateScaleAndRefreshLayout(const FGeometry& C
 {
 	if (!CalculateCurrentScale(CurrentGeometry)) return;
 	UpdateSizeBoxOverride();
-	if (ItemGridPanel)
+	if (UOBGridPanel* CellGridPanel = Cast<UOBGridPanel>(ItemGridPanel))
+	{
+		// Changing the scale invalidates the panel's layout itself; no fill redistribution needed.
+		CellGridPanel->SetGridScale(CurrentGridScale);
+	}
+	else if (ItemGridPanel)
 	{
 		ItemGridPanel->InvalidateLayoutAndVolatility();
 	}
@@ -427,29 +1580,18 @@ void UOBGridInventoryWidget::RecalculateScaleAndRefreshLayout(const FGeometry& C
 
 void UOBGridInventoryWidget::UpdateDummyCells()
 {
-	if (!ItemGridPanel || !DummyCellWidgetClass || GridConfig.NumRows <= 0 || GridConfig.NumColumns <= 0)
+	const FOBGridOccupancy& Occupancy = ItemState->GetOccupancy();
+	if (!ItemGridPanel || !DummyCellWidgetClass || IsPaintingItems() || Occupancy.GetNumRows() <= 0 ||
+		Occupancy.GetNumColumns() <= 0)
 	{
 		return;
 	}
 
-	TSet<FIntPoint> OccupiedCells;
-	for (const auto& Pair : PlacedItemInfoMap)
-	{
-		if (!Pair.Key) continue;
-		const auto& Info = Pair.Value;
-		for (int32 r = Info.Row; r < Info.Row + Info.RowSpan; ++r)
-		{
-			for (int32 c = Info.Column; c < Info.Column + Info.ColumnSpan; ++c)
-			{
-				OccupiedCells.Add(FIntPoint(c, r));
-			}
-		}
-	}
-
 	TSet<FIntPoint> DummiesToRemove;
 	for (const auto& Pair : DummyCellWidgetsMap)
 	{
-		if (OccupiedCells.Contains(Pair.Key) || !Pair.Value.IsValid())
+		if (Occupancy.GetCell(Pair.Key.Y, Pair.Key.X) != FOBGridOccupancy::FreeCell ||
+			!Occupancy.IsCellEnabled(Pair.Key.Y, Pair.Key.X) || !Pair.Value.IsValid())
 		{
 			DummiesToRemove.Add(Pair.Key);
 		}
@@ -460,32 +1602,61 @@ void UOBGridInventoryWidget::UpdateDummyCells()
 		RemoveDummyWidgetAt(Coord);
 	}
 
-	for (int32 r = 0; r < GridConfig.NumRows; ++r)
+	for (int32 r = 0; r < Occupancy.GetNumRows(); ++r)
 	{
-		for (int32 c = 0; c < GridConfig.NumColumns; ++c)
+		for (int32 c = 0; c < Occupancy.GetNumColumns(); ++c)
 		{
 			const FIntPoint CurrentCoord(c, r);
-			if (!OccupiedCells.Contains(CurrentCoord) && !DummyCellWidgetsMap.Contains(CurrentCoord))
+			if (Occupancy.GetCell(r, c) == FOBGridOccupancy::FreeCell && Occupancy.IsCellEnabled(r, c) &&
+				!DummyCellWidgetsMap.Contains(CurrentCoord))
+			{
+				TryAddDummyWidgetAt(r, c);
+			}
+		}
+	}
+}
+
+void UOBGridInventoryWidget::RefreshDummyCellsInArea(const int32 TopLeftRow, const int32 TopLeftCol,
+													  const int32 NumAreaRows, const int32 NumAreaCols)
+{
+	if (!ItemGridPanel || !DummyCellWidgetClass || IsPaintingItems()) return;
+
+	const FOBGridOccupancy& Occupancy = ItemState->GetOccupancy();
+	const int32 RowEnd = FMath::Min(TopLeftRow + NumAreaRows, Occupancy.GetNumRows());
+	const int32 ColEnd = FMath::Min(TopLeftCol + NumAreaCols, Occupancy.GetNumColumns());
+	for (int32 r = FMath::Max(TopLeftRow, 0); r < RowEnd; ++r)
+	{
+		for (int32 c = FMath::Max(TopLeftCol, 0); c < ColEnd; ++c)
+		{
+			if (Occupancy.GetCell(r, c) == FOBGridOccupancy::FreeCell && Occupancy.IsCellEnabled(r, c))
 			{
 				TryAddDummyWidgetAt(r, c);
 			}
+			else
+			{
+				RemoveDummyWidgetAt(FIntPoint(c, r));
+			}
 		}
 	}
 }
 
 bool UOBGridInventoryWidget::TryAddDummyWidgetAt(const int32 Row, const int32 Column)
 {
-	if (!ItemGridPanel || !DummyCellWidgetClass) return false;
+	if (!ItemGridPanel || !DummyCellWidgetClass || IsPaintingItems()) return false;
 	const FIntPoint Coord(Column, Row);
 	if (DummyCellWidgetsMap.Contains(Coord) && DummyCellWidgetsMap[Coord].IsValid()) return true;
 
 	if (UUserWidget* NewDummyWidget = CreateWidget<UUserWidget>(this, DummyCellWidgetClass))
 	{
-		if (UGridSlot* GridSlot = ItemGridPanel->AddChildToGrid(NewDummyWidget, Row, Column))
+		if (!bDummyCellsHitTestable)
+		{
+			// Keeps filler cells out of Slate's hit-test grid; cells are resolved through AbsoluteToCell instead.
+			NewDummyWidget->SetVisibility(ESlateVisibility::HitTestInvisible);
+		}
+		if (AddChildToCell(NewDummyWidget, Row, Column, 1, 1))
 		{
-			GridSlot->SetHorizontalAlignment(EHorizontalAlignment::HAlign_Fill);
-			GridSlot->SetVerticalAlignment(EVerticalAlignment::VAlign_Fill);
 			DummyCellWidgetsMap.Add(Coord, NewDummyWidget);
+			DummyCellsByWidget.Add(NewDummyWidget, Coord);
 			return true;
 		}
 	}
@@ -503,6 +1674,7 @@ void UOBGridInventoryWidget::RemoveDummyWidgetAt(const FIntPoint& Coord)
 				ItemGridPanel->RemoveChild(DummyWidget);
 			}
 		}
+		DummyCellsByWidget.Remove(*FoundWidgetPtr);
 		DummyCellWidgetsMap.Remove(Coord);
 	}
 }
@@ -510,15 +1682,98 @@ void UOBGridInventoryWidget::RemoveDummyWidgetAt(const FIntPoint& Coord)
 void UOBGridInventoryWidget::SetupGridPanelDimensions()
 {
 	if (!ItemGridPanel) return;
-	ItemGridPanel->ClearChildren();
-	PlacedItemInfoMap.Empty();
-	DummyCellWidgetsMap.Empty();
-	for (int32 c = 0; c < GridConfig.NumColumns; ++c)
+	// GridConfig only initializes the state this widget owns; a bound state keeps its own layout.
+	if (ItemState == OwnedItemState)
+	{
+		FOBGridTraceScope Trace(ItemState, EOBGridTraceOp::InitializeGrid, GridConfig.NumRows, GridConfig.NumColumns);
+		Trace.SetLayout(GridConfig.Sections, GridConfig.DisabledCells);
+		ItemState->Initialize(GridConfig.NumRows, GridConfig.NumColumns, GridConfig.Sections,
+							  GridConfig.DisabledCells);
+		Trace.SetSucceeded(true);
+	}
+	RebuildPresentation();
+}
+
+void UOBGridInventoryWidget::SetTrackFills(const int32 OldRows, const int32 OldColumns, const int32 NewRows,
+										   const int32 NewColumns) const
+{
+	UGridPanel* LegacyGridPanel = Cast<UGridPanel>(ItemGridPanel);
+	if (!LegacyGridPanel) return;
+	// Added tracks get a share of the space; removed tracks collapse to zero since UGridPanel cannot drop them.
+	for (int32 c = FMath::Min(OldColumns, NewColumns); c < FMath::Max(OldColumns, NewColumns); ++c)
+	{
+		LegacyGridPanel->SetColumnFill(c, c < NewColumns ? 1.0f : 0.0f);
+	}
+	for (int32 r = FMath::Min(OldRows, NewRows); r < FMath::Max(OldRows, NewRows); ++r)
+	{
+		LegacyGridPanel->SetRowFill(r, r < NewRows ? 1.0f : 0.0f);
+	}
+}
+
+
+bool UOBGridInventoryWidget::FlushPendingChanges(float DeltaTime)
+{
+	PendingFlushHandle.Reset();
+
+	const FOBGridChangeJournal& ChangeJournal = ItemState->GetChangeJournal();
+	TConstArrayView<FOBGridChangeRecord> Records;
+	const bool bComplete = ChangeJournal.GetChangesSince(LastFlushedSequence, Records);
+	LastFlushedSequence = ChangeJournal.GetLatestSequence();
+	if (!bComplete)
+	{
+		// More changes than the journal retains happened this frame; tell listeners to resync.
+		FOBGridChangeRecord ResetRecord;
+		ResetRecord.Sequence = LastFlushedSequence;
+		ResetRecord.Type = EOBGridChangeType::Reset;
+		OnChangesFlushed.Broadcast(this, MakeArrayView(&ResetRecord, 1));
+	}
+	else if (!Records.IsEmpty())
+	{
+		OnChangesFlushed.Broadcast(this, Records);
+	}
+
+	// Returning false unregisters this one-shot ticker.
+	return false;
+}
+
+UPanelSlot* UOBGridInventoryWidget::AddChildToCell(UWidget* Content, const int32 Row, const int32 Column,
+												   const int32 RowSpan, const int32 ColumnSpan) const
+{
+	if (UOBGridPanel* CellGridPanel = Cast<UOBGridPanel>(ItemGridPanel))
+	{
+		return CellGridPanel->AddChildToCell(Content, Row, Column, RowSpan, ColumnSpan);
+	}
+	if (UGridPanel* LegacyGridPanel = Cast<UGridPanel>(ItemGridPanel))
+	{
+		if (UGridSlot* GridSlot = LegacyGridPanel->AddChildToGrid(Content, Row, Column))
+		{
+			GridSlot->SetRowSpan(RowSpan);
+			GridSlot->SetColumnSpan(ColumnSpan);
+			GridSlot->SetHorizontalAlignment(HAlign_Fill);
+			GridSlot->SetVerticalAlignment(VAlign_Fill);
+			return GridSlot;
+		}
+		return nullptr;
+	}
+
+	UE_LOG(LogTemp, Error, TEXT("[%s::%hs] - ItemGridPanel '%s' must be a UOBGridPanel or a UGridPanel."),
+		   *GetNameSafe(this), __FUNCTION__, *GetNameSafe(ItemGridPanel));
+	return nullptr;
+}
+
+bool UOBGridInventoryWidget::SetChildCell(const UWidget* Content, const int32 Row, const int32 Column)
+{
+	if (!Content) return false;
+	if (UOBGridPanelSlot* CellSlot = Cast<UOBGridPanelSlot>(Content->Slot))
 	{
-		ItemGridPanel->SetColumnFill(c, 1.0f);
+		CellSlot->SetCell(Row, Column);
+		return true;
 	}
-	for (int32 r = 0; r < GridConfig.NumRows; ++r)
+	if (UGridSlot* GridSlot = Cast<UGridSlot>(Content->Slot))
 	{
-		ItemGridPanel->SetRowFill(r, 1.0f);
+		GridSlot->SetRow(Row);
+		GridSlot->SetColumn(Column);
+		return true;
 	}
+	return false;
 }
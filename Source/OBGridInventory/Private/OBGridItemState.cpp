@@ -0,0 +1,849 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridItemState.h"
+
+#include "Blueprint/UserWidget.h"
+#include "OBGridTrace.h"
+
+UOBGridItemState::FChangeScope::FChangeScope(UOBGridItemState& InState)
+	: State(InState)
+{
+	++State.ChangeScopeDepth;
+}
+
+UOBGridItemState::FChangeScope::~FChangeScope()
+{
+	if (--State.ChangeScopeDepth > 0) return;
+	if (const int64 LatestSequence = State.ChangeJournal.GetLatestSequence();
+		LatestSequence != State.NotifiedSequence)
+	{
+		State.NotifiedSequence = LatestSequence;
+		if (State.bPublishSnapshots)
+		{
+			State.ScheduleSnapshotPublish();
+		}
+		State.OnChanged.Broadcast(&State);
+	}
+}
+
+// --- Layout ---
+
+void UOBGridItemState::Initialize(const int32 NumRows, const int32 NumColumns,
+								  const TArray<FOBGridSection>& InSections, const TArray<FIntPoint>& InDisabledCells)
+{
+	FChangeScope ChangeScope(*this);
+	const bool bHadHistory = !Items.IsEmpty() || ChangeJournal.GetLatestSequence() > 0;
+	Items.Empty();
+	WidgetClassesById.Empty();
+	PartialStackIndex.Empty();
+	SnapshotPayloads.Empty();
+	PayloadPool.Empty();
+	Reservations.Empty();
+	ReservationIdsByItem.Empty();
+	Sections = InSections;
+	DisabledCells = InDisabledCells;
+	Occupancy.Reset(FMath::Max(NumRows, 0), FMath::Max(NumColumns, 0));
+	ApplyCellLayout(Occupancy, Sections, DisabledCells);
+	Aggregates.ResetValues();
+	NumOccupiedCells = 0;
+	RefreshEnabledCellCount();
+	if (bHadHistory)
+	{
+		RecordChange(EOBGridChangeType::Reset, FOBGridItemInfo());
+	}
+	else
+	{
+		RecordLayoutChange();
+	}
+}
+
+bool UOBGridItemState::Resize(int32 NewRows, int32 NewColumns, const EOBGridResizePolicy OutOfBoundsPolicy,
+							  TArray<FOBGridItemInfo>& OutOverflowedItems)
+{
+	OutOverflowedItems.Reset();
+	NewRows = FMath::Max(NewRows, 1);
+	NewColumns = FMath::Max(NewColumns, 1);
+	if (NewRows == Occupancy.GetNumRows() && NewColumns == Occupancy.GetNumColumns()) return true;
+
+	// 1. Collect the items that would end up out of bounds. A pending item, or the cells it holds for a rollback,
+	// cannot be relocated or dropped behind the authority's back: such a resize has to wait for the answer.
+	TArray<int32> OutOfBoundsItemIds;
+	for (const TPair<int32, FOBGridItemInfo>& Pair : Items)
+	{
+		if (const FOBGridItemInfo& Info = Pair.Value;
+			Info.Row + Info.RowSpan > NewRows || Info.Column + Info.ColumnSpan > NewColumns)
+		{
+			OutOfBoundsItemIds.Add(Pair.Key);
+		}
+	}
+	for (const TPair<int32, FReservation>& Pair : Reservations)
+	{
+		if (const FReservation& Reservation = Pair.Value; OutOfBoundsItemIds.Contains(Reservation.ItemId) ||
+			Reservation.Row + Reservation.RowSpan > NewRows || Reservation.Column + Reservation.ColumnSpan > NewColumns)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Resize to %dx%d refused: item %d has a pending move there."),
+				   *GetNameSafe(this), __FUNCTION__, NewRows, NewColumns, Reservation.ItemId);
+			return false;
+		}
+	}
+
+	// 2. Plan relocations on a copy, so a refused resize leaves everything untouched.
+	FOBGridOccupancy NewOccupancy = Occupancy;
+	TMap<int32, FIntPoint> Relocations;
+	if (!OutOfBoundsItemIds.IsEmpty())
+	{
+		if (OutOfBoundsPolicy == EOBGridResizePolicy::Reject)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Resize to %dx%d rejected: %d item(s) would be out of bounds."),
+				   *GetNameSafe(this), __FUNCTION__, NewRows, NewColumns, OutOfBoundsItemIds.Num());
+			return false;
+		}
+
+		for (const int32 ItemId : OutOfBoundsItemIds)
+		{
+			const FOBGridItemInfo& Info = Items.FindChecked(ItemId);
+			NewOccupancy.Clear(Info.Row, Info.Column, Info.RowSpan, Info.ColumnSpan);
+		}
+	}
+	NewOccupancy.Resize(NewRows, NewColumns);
+	ApplyCellLayout(NewOccupancy, Sections, DisabledCells);
+
+	if (OutOfBoundsPolicy == EOBGridResizePolicy::Repack && !OutOfBoundsItemIds.IsEmpty())
+	{
+		// Largest items first gives the first-fit scan the best chance.
+		OutOfBoundsItemIds.Sort([this](const int32 A, const int32 B)
+		{
+			const FOBGridItemInfo& InfoA = Items.FindChecked(A);
+			const FOBGridItemInfo& InfoB = Items.FindChecked(B);
+			return InfoA.RowSpan * InfoA.ColumnSpan > InfoB.RowSpan * InfoB.ColumnSpan;
+		});
+
+		for (const int32 ItemId : OutOfBoundsItemIds)
+		{
+			const FOBGridItemInfo& Info = Items.FindChecked(ItemId);
+			int32 TargetRow = -1;
+			int32 TargetCol = -1;
+			if (!NewOccupancy.FindFreeSlot(Info.RowSpan, Info.ColumnSpan, TargetRow, TargetCol))
+			{
+				UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Resize to %dx%d refused: item %d cannot be repacked."),
+					   *GetNameSafe(this), __FUNCTION__, NewRows, NewColumns, ItemId);
+				return false;
+			}
+			NewOccupancy.Fill(TargetRow, TargetCol, Info.RowSpan, Info.ColumnSpan, Info.ItemId);
+			Relocations.Add(ItemId, FIntPoint(TargetCol, TargetRow));
+		}
+	}
+
+	// 3. Commit. Overflowing items leave the grid before the bounds change.
+	FChangeScope ChangeScope(*this);
+	if (OutOfBoundsPolicy == EOBGridResizePolicy::Overflow)
+	{
+		for (const int32 ItemId : OutOfBoundsItemIds)
+		{
+			OutOverflowedItems.Add(Items.FindChecked(ItemId).WithOwnedPayload());
+			RemoveItem(ItemId);
+		}
+	}
+
+	Occupancy = MoveTemp(NewOccupancy);
+	RefreshEnabledCellCount();
+	RecordLayoutChange();
+
+	for (const TPair<int32, FIntPoint>& Relocation : Relocations)
+	{
+		FOBGridItemInfo& Info = Items.FindChecked(Relocation.Key);
+		Info.Row = Relocation.Value.Y;
+		Info.Column = Relocation.Value.X;
+		RecordChange(EOBGridChangeType::Moved, Info);
+	}
+	return true;
+}
+
+bool UOBGridItemState::SetLayout(const TArray<FOBGridSection>& NewSections, const TArray<FIntPoint>& NewDisabledCells)
+{
+	FOBGridOccupancy NewOccupancy = Occupancy;
+	ApplyCellLayout(NewOccupancy, NewSections, NewDisabledCells);
+
+	for (const TPair<int32, FOBGridItemInfo>& Pair : Items)
+	{
+		if (const FOBGridItemInfo& Info = Pair.Value;
+			!NewOccupancy.IsAreaClear(Info.Row, Info.Column, Info.RowSpan, Info.ColumnSpan, Info.ItemId))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - Layout refused: item %d would be masked or cross a section."),
+				   *GetNameSafe(this), __FUNCTION__, Pair.Key);
+			return false;
+		}
+	}
+
+	// The held cells must stay usable, or a rollback could not put the item back.
+	for (const TPair<int32, FReservation>& Pair : Reservations)
+	{
+		if (const FReservation& Reservation = Pair.Value;
+			!NewOccupancy.IsAreaClear(Reservation.Row, Reservation.Column, Reservation.RowSpan,
+									  Reservation.ColumnSpan, Reservation.ItemId, Reservation.GetArea()))
+		{
+			UE_LOG(LogTemp, Warning,
+				   TEXT("[%s::%hs] - Layout refused: the cells held for item %d would be masked or cross a section."),
+				   *GetNameSafe(this), __FUNCTION__, Reservation.ItemId);
+			return false;
+		}
+	}
+
+	FChangeScope ChangeScope(*this);
+	Sections = NewSections;
+	DisabledCells = NewDisabledCells;
+	Occupancy = MoveTemp(NewOccupancy);
+	RefreshEnabledCellCount();
+	RecordLayoutChange();
+	return true;
+}
+
+int32 UOBGridItemState::FindSectionIndex(const FName SectionName) const
+{
+	return Sections.IndexOfByPredicate([SectionName](const FOBGridSection& Section)
+	{
+		return Section.SectionName == SectionName;
+	});
+}
+
+// --- Items ---
+
+int32 UOBGridItemState::AddItemAt(const FInstancedStruct& ItemPayload, const int32 ItemRows, const int32 ItemCols,
+								  const int32 RowTopLeft, const int32 ColTopLeft,
+								  const TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (!PassesCapacityRules(ItemPayload, FConstStructView())) return INDEX_NONE;
+	if (!Occupancy.IsAreaClear(RowTopLeft, ColTopLeft, ItemRows, ItemCols))
+	{
+		UE_LOG(LogTemp, Warning,
+			   TEXT("[%s::%hs] - Failed to add item. Target area at [%d, %d] with size [%d, %d] is not clear."),
+			   *GetNameSafe(this), __FUNCTION__, RowTopLeft, ColTopLeft, ItemRows, ItemCols);
+		return INDEX_NONE;
+	}
+	return AddItemInternal(ItemPayload, ItemRows, ItemCols, RowTopLeft, ColTopLeft, WidgetClass);
+}
+
+int32 UOBGridItemState::AddItem(const FInstancedStruct& ItemPayload, const int32 ItemRows, const int32 ItemCols,
+								const TSubclassOf<UUserWidget> WidgetClass, const int32 SectionIndex)
+{
+	if (!PassesCapacityRules(ItemPayload, FConstStructView())) return INDEX_NONE;
+
+	int32 FoundRow = -1;
+	int32 FoundCol = -1;
+	if (!Occupancy.FindFreeSlot(ItemRows, ItemCols, FoundRow, FoundCol, SectionIndex))
+	{
+		UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - No available space found for item size %dx%d."), *GetNameSafe(this),
+			   __FUNCTION__, ItemRows, ItemCols);
+		return INDEX_NONE;
+	}
+	return AddItemInternal(ItemPayload, ItemRows, ItemCols, FoundRow, FoundCol, WidgetClass);
+}
+
+bool UOBGridItemState::AddStackableItem(const FInstancedStruct& ItemPayload, const int32 ItemRows,
+										const int32 ItemCols, const TSubclassOf<UUserWidget> WidgetClass,
+										const bool bAllowNewStacks, FOBGridStackAddResult& OutResult)
+{
+	OutResult = FOBGridStackAddResult();
+	FChangeScope ChangeScope(*this);
+
+	const FOBGridStackablePayload* IncomingStack = ItemPayload.GetPtr<FOBGridStackablePayload>();
+	if (!IncomingStack || !IncomingStack->IsStackable())
+	{
+		// A quantity that cannot stack becomes that many single items, never one stack above its MaxStackSize.
+		// Only a payload without any quantity counts as one item; an empty quantity places nothing, as for stacks.
+		const int32 Quantity = IncomingStack ? IncomingStack->Quantity : 1;
+		if (Quantity <= 0) return true;
+
+		FInstancedStruct SinglePayload = ItemPayload;
+		if (Quantity > 1)
+		{
+			SinglePayload.GetMutablePtr<FOBGridStackablePayload>()->Quantity = 1;
+		}
+
+		for (int32 Index = 0; bAllowNewStacks && Index < Quantity; ++Index)
+		{
+			const int32 NewItemId = AddItem(SinglePayload, ItemRows, ItemCols, WidgetClass);
+			if (NewItemId == INDEX_NONE) break;
+			OutResult.PlacedItemIds.Add(NewItemId);
+		}
+		OutResult.QuantityPlaced = FMath::Min(OutResult.PlacedItemIds.Num(), Quantity);
+		OutResult.QuantityRemaining = Quantity - OutResult.QuantityPlaced;
+		return OutResult.PlacedItemIds.Num() == Quantity;
+	}
+
+	// Quantity-scaled limits (weight...) cap the whole add up front; the rest is reported as remaining.
+	const int32 Refused = IncomingStack->Quantity -
+		Aggregates.GetAcceptableQuantity(CapacityRules, ItemPayload, IncomingStack->Quantity);
+	int32 Remaining = IncomingStack->Quantity - Refused;
+
+	// 1. Top up existing partial stacks. Copy the candidates since SetItemPayload re-indexes filled stacks.
+	if (const TArray<int32>* FoundStacks = PartialStackIndex.Find(IncomingStack->StackKey))
+	{
+		const TArray<int32> Candidates = *FoundStacks;
+		for (const int32 StackItemId : Candidates)
+		{
+			if (Remaining <= 0) break;
+			const FOBGridItemInfo* StackInfo = Items.Find(StackItemId);
+			if (!StackInfo) continue;
+
+			FInstancedStruct UpdatedPayload = StackInfo->CopyPayload();
+			FOBGridStackablePayload* ExistingStack = UpdatedPayload.GetMutablePtr<FOBGridStackablePayload>();
+			if (!ExistingStack || !ExistingStack->IsPartialStack()) continue;
+
+			const int32 Transfer = FMath::Min(Remaining, ExistingStack->MaxStackSize - ExistingStack->Quantity);
+			ExistingStack->Quantity += Transfer;
+			if (SetItemPayload(StackItemId, UpdatedPayload))
+			{
+				Remaining -= Transfer;
+				OutResult.QuantityMerged += Transfer;
+				FOBGridStackMerge& Merge = OutResult.MergedStacks.AddDefaulted_GetRef();
+				Merge.ItemId = StackItemId;
+				Merge.QuantityAdded = Transfer;
+			}
+		}
+	}
+
+	// 2. Split the overflow into new placements.
+	if (Remaining > 0 && bAllowNewStacks && ItemRows > 0 && ItemCols > 0)
+	{
+		const int32 MaxPerStack = FMath::Max(IncomingStack->MaxStackSize, 1);
+		while (Remaining > 0)
+		{
+			const int32 StackQuantity = FMath::Min(Remaining, MaxPerStack);
+			FInstancedStruct NewStackPayload = ItemPayload;
+			NewStackPayload.GetMutablePtr<FOBGridStackablePayload>()->Quantity = StackQuantity;
+			if (!PassesCapacityRules(NewStackPayload, FConstStructView())) break;
+
+			int32 FoundRow = -1;
+			int32 FoundCol = -1;
+			if (!Occupancy.FindFreeSlot(ItemRows, ItemCols, FoundRow, FoundCol)) break;
+
+			const int32 NewItemId = AddItemInternal(NewStackPayload, ItemRows, ItemCols, FoundRow, FoundCol,
+													WidgetClass);
+			if (NewItemId == INDEX_NONE) break;
+
+			Remaining -= StackQuantity;
+			OutResult.QuantityPlaced += StackQuantity;
+			OutResult.PlacedItemIds.Add(NewItemId);
+		}
+	}
+
+	Remaining += Refused;
+	OutResult.QuantityRemaining = Remaining;
+	if (Remaining > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Stack '%s': merged %d, placed %d, %d left over (%d over capacity)."),
+			   *GetNameSafe(this), __FUNCTION__, *IncomingStack->StackKey.ToString(), OutResult.QuantityMerged,
+			   OutResult.QuantityPlaced, Remaining, Refused);
+	}
+	return Remaining <= 0;
+}
+
+bool UOBGridItemState::RemoveItem(const int32 ItemId)
+{
+	FOBGridItemInfo RemovedInfo;
+	if (!Items.RemoveAndCopyValue(ItemId, RemovedInfo)) return false;
+
+	FChangeScope ChangeScope(*this);
+	DropItemReservation(ItemId);
+	WidgetClassesById.Remove(ItemId);
+	SnapshotPayloads.Remove(ItemId);
+	UnindexPartialStack(ItemId, RemovedInfo.GetPayload());
+	Aggregates.RemovePayload(RemovedInfo.GetPayload());
+	PayloadPool.Release(RemovedInfo.SharedPayload);
+	Occupancy.Clear(RemovedInfo.Row, RemovedInfo.Column, RemovedInfo.RowSpan, RemovedInfo.ColumnSpan);
+	NumOccupiedCells -= RemovedInfo.RowSpan * RemovedInfo.ColumnSpan;
+	bLargestFreeRectDirty = true;
+	RecordChange(EOBGridChangeType::Removed, RemovedInfo);
+	return true;
+}
+
+bool UOBGridItemState::MoveItem(const int32 ItemId, const int32 NewRowTopLeft, const int32 NewColTopLeft)
+{
+	FOBGridItemInfo* ItemInfo = Items.Find(ItemId);
+	if (!ItemInfo) return false;
+
+	// An authoritative move wins over a pending one, and may land on the cells it held. A refused move leaves the
+	// reservation pending.
+	if (!IsAreaClearForItem(Occupancy, ItemId, NewRowTopLeft, NewColTopLeft, ItemInfo->RowSpan, ItemInfo->ColumnSpan))
+	{
+		return false;
+	}
+
+	FChangeScope ChangeScope(*this);
+	DropItemReservation(ItemId);
+	Occupancy.Clear(ItemInfo->Row, ItemInfo->Column, ItemInfo->RowSpan, ItemInfo->ColumnSpan);
+	ItemInfo->Row = NewRowTopLeft;
+	ItemInfo->Column = NewColTopLeft;
+	Occupancy.Fill(ItemInfo->Row, ItemInfo->Column, ItemInfo->RowSpan, ItemInfo->ColumnSpan, ItemId);
+	bLargestFreeRectDirty = true;
+	RecordChange(EOBGridChangeType::Moved, *ItemInfo);
+	return true;
+}
+
+bool UOBGridItemState::SetItemPayload(const int32 ItemId, const FInstancedStruct& NewPayload)
+{
+	FOBGridItemInfo* ItemInfo = Items.Find(ItemId);
+	if (!ItemInfo || !PassesCapacityRules(NewPayload, ItemInfo->GetPayload())) return false;
+
+	FChangeScope ChangeScope(*this);
+	UnindexPartialStack(ItemId, ItemInfo->GetPayload());
+	Aggregates.RemovePayload(ItemInfo->GetPayload());
+	StorePayload(*ItemInfo, NewPayload);
+	SnapshotPayloads.Remove(ItemId);
+	Aggregates.AddPayload(ItemInfo->GetPayload());
+	IndexPartialStack(ItemId, ItemInfo->GetPayload());
+	RecordChange(EOBGridChangeType::PayloadChanged, *ItemInfo);
+	return true;
+}
+
+void UOBGridItemState::ClearItems()
+{
+	FChangeScope ChangeScope(*this);
+	TArray<int32> AllItemIds;
+	Items.GenerateKeyArray(AllItemIds);
+	for (const int32 ItemId : AllItemIds)
+	{
+		RemoveItem(ItemId);
+	}
+}
+
+// --- Payload Interning ---
+
+void UOBGridItemState::SetInternPayloads(const bool bEnable)
+{
+	if (bInternPayloads == bEnable) return;
+	bInternPayloads = bEnable;
+
+	// Payload contents do not change, so no journal record; views keep what they present.
+	for (TPair<int32, FOBGridItemInfo>& Pair : Items)
+	{
+		FOBGridItemInfo& ItemInfo = Pair.Value;
+		if (bEnable)
+		{
+			ItemInfo.SharedPayload = PayloadPool.Intern(ItemInfo.ItemPayload);
+			ItemInfo.ItemPayload.Reset();
+		}
+		else
+		{
+			ItemInfo.ItemPayload = ItemInfo.CopyPayload();
+			ItemInfo.SharedPayload = FConstSharedStruct();
+		}
+	}
+	if (!bEnable)
+	{
+		PayloadPool.Empty();
+	}
+	SnapshotPayloads.Empty();
+
+	UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Payload interning %s: %d item(s), %d distinct payload(s)."),
+		   *GetNameSafe(this), __FUNCTION__, bEnable ? TEXT("on") : TEXT("off"), Items.Num(),
+		   PayloadPool.GetNumDistinct());
+}
+
+// --- Reservations ---
+
+int32 UOBGridItemState::ReserveMove(const int32 ItemId, const int32 NewRowTopLeft, const int32 NewColTopLeft)
+{
+	// Reservations are traced here rather than by a view, since move authorities answer on the state directly.
+	FOBGridTraceScope Trace(this, EOBGridTraceOp::ReserveMove, ItemId, NewRowTopLeft, NewColTopLeft);
+	FOBGridItemInfo* ItemInfo = Items.Find(ItemId);
+	if (!ItemInfo || ReservationIdsByItem.Contains(ItemId)) return INDEX_NONE;
+	if ((ItemInfo->Row == NewRowTopLeft && ItemInfo->Column == NewColTopLeft) ||
+		!Occupancy.IsAreaClear(NewRowTopLeft, NewColTopLeft, ItemInfo->RowSpan, ItemInfo->ColumnSpan, ItemId))
+	{
+		return INDEX_NONE;
+	}
+
+	FChangeScope ChangeScope(*this);
+	const int32 ReservationId = NextReservationId++;
+	FReservation& Reservation = Reservations.Add(ReservationId);
+	Reservation.ItemId = ItemId;
+	Reservation.Row = ItemInfo->Row;
+	Reservation.Column = ItemInfo->Column;
+	Reservation.RowSpan = ItemInfo->RowSpan;
+	Reservation.ColumnSpan = ItemInfo->ColumnSpan;
+	ReservationIdsByItem.Add(ItemId, ReservationId);
+
+	// The cells left behind, less those the item still covers after a short move, are held.
+	Occupancy.Clear(ItemInfo->Row, ItemInfo->Column, ItemInfo->RowSpan, ItemInfo->ColumnSpan);
+	ItemInfo->Row = NewRowTopLeft;
+	ItemInfo->Column = NewColTopLeft;
+	Occupancy.Fill(ItemInfo->Row, ItemInfo->Column, ItemInfo->RowSpan, ItemInfo->ColumnSpan, ItemId);
+	NumOccupiedCells += Occupancy.Replace(Reservation.Row, Reservation.Column, Reservation.RowSpan,
+										  Reservation.ColumnSpan, FOBGridOccupancy::FreeCell,
+										  FOBGridOccupancy::ReservedCell);
+	bLargestFreeRectDirty = true;
+	RecordChange(EOBGridChangeType::Moved, *ItemInfo);
+	RecordPendingChange(Reservation);
+	Trace.SetResult(ReservationId);
+	return ReservationId;
+}
+
+bool UOBGridItemState::ConfirmReservation(const int32 ReservationId)
+{
+	FOBGridTraceScope Trace(this, EOBGridTraceOp::ConfirmReservation, ReservationId);
+	FChangeScope ChangeScope(*this);
+	const bool bConfirmed = ReleaseReservation(ReservationId);
+	Trace.SetSucceeded(bConfirmed);
+	return bConfirmed;
+}
+
+bool UOBGridItemState::RollbackReservation(const int32 ReservationId)
+{
+	FOBGridTraceScope Trace(this, EOBGridTraceOp::RollbackReservation, ReservationId);
+	FReservation Reservation;
+	if (!Reservations.RemoveAndCopyValue(ReservationId, Reservation)) return false;
+	ReservationIdsByItem.Remove(Reservation.ItemId);
+
+	// Only this reservation held those cells, so the item always fits back.
+	FChangeScope ChangeScope(*this);
+	FOBGridItemInfo& ItemInfo = Items.FindChecked(Reservation.ItemId);
+	Occupancy.Clear(ItemInfo.Row, ItemInfo.Column, ItemInfo.RowSpan, ItemInfo.ColumnSpan);
+	NumOccupiedCells -= Occupancy.Replace(Reservation.Row, Reservation.Column, Reservation.RowSpan,
+										  Reservation.ColumnSpan, FOBGridOccupancy::ReservedCell,
+										  FOBGridOccupancy::FreeCell);
+	ItemInfo.Row = Reservation.Row;
+	ItemInfo.Column = Reservation.Column;
+	Occupancy.Fill(ItemInfo.Row, ItemInfo.Column, ItemInfo.RowSpan, ItemInfo.ColumnSpan, ItemInfo.ItemId);
+	bLargestFreeRectDirty = true;
+	RecordChange(EOBGridChangeType::Moved, ItemInfo);
+	RecordPendingChange(Reservation);
+	Trace.SetSucceeded(true);
+	return true;
+}
+
+void UOBGridItemState::RollbackAllReservations()
+{
+	if (Reservations.IsEmpty()) return;
+
+	FChangeScope ChangeScope(*this);
+	TArray<int32> ReservationIds;
+	Reservations.GenerateKeyArray(ReservationIds);
+	for (const int32 ReservationId : ReservationIds)
+	{
+		RollbackReservation(ReservationId);
+	}
+}
+
+// --- Snapshots ---
+
+void UOBGridItemState::SetPublishSnapshots(const bool bEnable)
+{
+	if (bPublishSnapshots == bEnable) return;
+	bPublishSnapshots = bEnable;
+	SnapshotPayloads.Empty();
+
+	// Disabling publishes a null snapshot, so readers stop seeing a state that is no longer kept up to date.
+	PublishSnapshot();
+}
+
+// --- Aggregates ---
+
+void UOBGridItemState::RegisterAggregate(const FOBGridAggregateSpec& Spec)
+{
+	if (Spec.AggregateName.IsNone())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - Aggregates need a name."), *GetNameSafe(this), __FUNCTION__);
+		return;
+	}
+
+	Aggregates.Register(Spec);
+	const int32 AggregateIndex = Aggregates.GetSpecs().Num() - 1;
+	for (const TPair<int32, FOBGridItemInfo>& Pair : Items)
+	{
+		Aggregates.AddPayload(Pair.Value.GetPayload(), AggregateIndex);
+	}
+}
+
+bool UOBGridItemState::UnregisterAggregate(const FName AggregateName)
+{
+	return Aggregates.Unregister(AggregateName);
+}
+
+bool UOBGridItemState::GetAggregateValue(const FName AggregateName, double& OutValue) const
+{
+	return Aggregates.GetValue(AggregateName, OutValue);
+}
+
+bool UOBGridItemState::CanAcceptPayload(const FInstancedStruct& ItemPayload, FName& OutViolatedRule) const
+{
+	return Aggregates.CheckRules(CapacityRules, ItemPayload, FConstStructView(), OutViolatedRule);
+}
+
+int32 UOBGridItemState::GetLargestFreeRect(int32& OutRow, int32& OutColumn, int32& OutNumRows,
+										   int32& OutNumColumns) const
+{
+	if (bLargestFreeRectDirty)
+	{
+		LargestFreeRect = Occupancy.FindLargestFreeRect();
+		bLargestFreeRectDirty = false;
+	}
+	OutRow = LargestFreeRect.Min.Y;
+	OutColumn = LargestFreeRect.Min.X;
+	OutNumRows = LargestFreeRect.Height();
+	OutNumColumns = LargestFreeRect.Width();
+	return OutNumRows * OutNumColumns;
+}
+
+// --- Queries ---
+
+int32 UOBGridItemState::GetItemIdAtCell(const int32 Row, const int32 Column) const
+{
+	const int32 ItemId = Occupancy.GetCell(Row, Column);
+	return ItemId > FOBGridOccupancy::FreeCell ? ItemId : INDEX_NONE;
+}
+
+TSubclassOf<UUserWidget> UOBGridItemState::GetItemWidgetClass(const int32 ItemId) const
+{
+	return WidgetClassesById.FindRef(ItemId);
+}
+
+SIZE_T UOBGridItemState::GetItemMapAllocatedSize() const
+{
+	SIZE_T Bytes = Items.GetAllocatedSize() + WidgetClassesById.GetAllocatedSize() + Sections.GetAllocatedSize() +
+		DisabledCells.GetAllocatedSize() + PartialStackIndex.GetAllocatedSize() + Aggregates.GetAllocatedSize() +
+		CapacityRules.GetAllocatedSize();
+	for (const TPair<FName, TArray<int32>>& Pair : PartialStackIndex)
+	{
+		Bytes += Pair.Value.GetAllocatedSize();
+	}
+	return Bytes + SnapshotPayloads.GetAllocatedSize() + Reservations.GetAllocatedSize() +
+		ReservationIdsByItem.GetAllocatedSize() + PayloadPool.GetAllocatedSize();
+}
+
+void UOBGridItemState::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+	CastChecked<UOBGridItemState>(InThis)->Aggregates.AddReferencedObjects(Collector);
+}
+
+void UOBGridItemState::BeginDestroy()
+{
+	if (SnapshotPublishHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SnapshotPublishHandle);
+		SnapshotPublishHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
+
+// --- Internal ---
+
+int32 UOBGridItemState::AddItemInternal(const FInstancedStruct& ItemPayload, const int32 ItemRows,
+										const int32 ItemCols, const int32 RowTopLeft, const int32 ColTopLeft,
+										const TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (ItemRows < 1 || ItemCols < 1) return INDEX_NONE;
+
+	FChangeScope ChangeScope(*this);
+	FOBGridItemInfo NewItemInfo(RowTopLeft, ColTopLeft, ItemRows, ItemCols, FInstancedStruct());
+	StorePayload(NewItemInfo, ItemPayload);
+	NewItemInfo.ItemId = NextItemId++;
+	const int32 ItemId = NewItemInfo.ItemId;
+	if (WidgetClass)
+	{
+		WidgetClassesById.Add(ItemId, WidgetClass);
+	}
+	Occupancy.Fill(RowTopLeft, ColTopLeft, ItemRows, ItemCols, ItemId);
+	NumOccupiedCells += ItemRows * ItemCols;
+	bLargestFreeRectDirty = true;
+	IndexPartialStack(ItemId, ItemPayload);
+	Aggregates.AddPayload(ItemPayload);
+	RecordChange(EOBGridChangeType::Added, Items.Add(ItemId, MoveTemp(NewItemInfo)));
+
+	UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Added item %d at (Row:%d, Col:%d), Span(Rows:%d, Cols:%d)"),
+		   *GetNameSafe(this), __FUNCTION__, ItemId, RowTopLeft, ColTopLeft, ItemRows, ItemCols);
+	return ItemId;
+}
+
+void UOBGridItemState::ApplyCellLayout(FOBGridOccupancy& TargetOccupancy, const TArray<FOBGridSection>& InSections,
+									   const TArray<FIntPoint>& InDisabledCells) const
+{
+	FOBGridInventoryConfig LayoutConfig;
+	LayoutConfig.Sections = InSections;
+	LayoutConfig.DisabledCells = InDisabledCells;
+	TArray<int32> CellSections;
+	LayoutConfig.BuildCellSections(TargetOccupancy.GetNumRows(), TargetOccupancy.GetNumColumns(), CellSections);
+	TargetOccupancy.SetCellSections(MoveTemp(CellSections));
+}
+
+void UOBGridItemState::IndexPartialStack(const int32 ItemId, const FConstStructView ItemPayload)
+{
+	if (const FOBGridStackablePayload* Stack = ItemPayload.GetPtr<FOBGridStackablePayload>();
+		Stack && Stack->IsPartialStack())
+	{
+		PartialStackIndex.FindOrAdd(Stack->StackKey).AddUnique(ItemId);
+	}
+}
+
+void UOBGridItemState::UnindexPartialStack(const int32 ItemId, const FConstStructView ItemPayload)
+{
+	const FOBGridStackablePayload* Stack = ItemPayload.GetPtr<FOBGridStackablePayload>();
+	if (!Stack || Stack->StackKey.IsNone()) return;
+
+	if (TArray<int32>* Stacks = PartialStackIndex.Find(Stack->StackKey))
+	{
+		Stacks->RemoveSingleSwap(ItemId);
+		if (Stacks->IsEmpty())
+		{
+			PartialStackIndex.Remove(Stack->StackKey);
+		}
+	}
+}
+
+void UOBGridItemState::StorePayload(FOBGridItemInfo& ItemInfo, const FInstancedStruct& Payload)
+{
+	if (!bInternPayloads)
+	{
+		ItemInfo.ItemPayload = Payload;
+		return;
+	}
+
+	// Intern before releasing, so an unchanged payload does not drop its only instance in between.
+	FConstSharedStruct SharedPayload = PayloadPool.Intern(Payload);
+	PayloadPool.Release(ItemInfo.SharedPayload);
+	ItemInfo.SharedPayload = MoveTemp(SharedPayload);
+	ItemInfo.ItemPayload.Reset();
+}
+
+void UOBGridItemState::RecordChange(const EOBGridChangeType Type, const FOBGridItemInfo& ItemInfo)
+{
+	ChangeJournal.Append(Type, ItemInfo.ItemId, ItemInfo.Row, ItemInfo.Column, ItemInfo.RowSpan, ItemInfo.ColumnSpan);
+}
+
+void UOBGridItemState::RecordLayoutChange()
+{
+	ChangeJournal.Append(EOBGridChangeType::LayoutChanged, INDEX_NONE, 0, 0, Occupancy.GetNumRows(),
+						 Occupancy.GetNumColumns());
+}
+
+void UOBGridItemState::RecordPendingChange(const FReservation& Reservation)
+{
+	ChangeJournal.Append(EOBGridChangeType::PendingChanged, Reservation.ItemId, Reservation.Row, Reservation.Column,
+						 Reservation.RowSpan, Reservation.ColumnSpan);
+}
+
+bool UOBGridItemState::ReleaseReservation(const int32 ReservationId)
+{
+	FReservation Reservation;
+	if (!Reservations.RemoveAndCopyValue(ReservationId, Reservation)) return false;
+
+	ReservationIdsByItem.Remove(Reservation.ItemId);
+	NumOccupiedCells -= Occupancy.Replace(Reservation.Row, Reservation.Column, Reservation.RowSpan,
+										  Reservation.ColumnSpan, FOBGridOccupancy::ReservedCell,
+										  FOBGridOccupancy::FreeCell);
+	bLargestFreeRectDirty = true;
+	RecordPendingChange(Reservation);
+	return true;
+}
+
+bool UOBGridItemState::IsAreaClearForItem(const FOBGridOccupancy& InOccupancy, const int32 ItemId,
+										  const int32 RowTopLeft, const int32 ColTopLeft, const int32 RowSpan,
+										  const int32 ColumnSpan) const
+{
+	const int32* ReservationId = ReservationIdsByItem.Find(ItemId);
+	const FIntRect HeldArea = ReservationId ? Reservations.FindChecked(*ReservationId).GetArea() : FIntRect();
+	return InOccupancy.IsAreaClear(RowTopLeft, ColTopLeft, RowSpan, ColumnSpan, ItemId, HeldArea);
+}
+
+void UOBGridItemState::DropItemReservation(const int32 ItemId)
+{
+	if (const int32* ReservationId = ReservationIdsByItem.Find(ItemId))
+	{
+		ReleaseReservation(*ReservationId);
+	}
+}
+
+bool UOBGridItemState::PassesCapacityRules(const FConstStructView NewPayload,
+										   const FConstStructView OldPayload) const
+{
+	if (CapacityRules.IsEmpty()) return true;
+
+	FName ViolatedRule;
+	if (Aggregates.CheckRules(CapacityRules, NewPayload, OldPayload, ViolatedRule)) return true;
+
+	UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Refused by capacity rule '%s'."), *GetNameSafe(this), __FUNCTION__,
+		   *ViolatedRule.ToString());
+	return false;
+}
+
+void UOBGridItemState::RefreshEnabledCellCount()
+{
+	NumEnabledCells = Occupancy.CountFreeCells() + NumOccupiedCells;
+	bLargestFreeRectDirty = true;
+}
+
+void UOBGridItemState::PublishSnapshot()
+{
+	TSharedPtr<FOBGridSnapshot, ESPMode::ThreadSafe> Snapshot;
+	if (bPublishSnapshots)
+	{
+		Snapshot = MakeShared<FOBGridSnapshot, ESPMode::ThreadSafe>();
+		BuildSnapshot(*Snapshot);
+	}
+
+	if (SnapshotChannel->Publish(Snapshot))
+	{
+		if (SnapshotPublishHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(SnapshotPublishHandle);
+			SnapshotPublishHandle.Reset();
+		}
+		return;
+	}
+
+	// Every spare slot is being read: readers keep the previous snapshot, try again next frame.
+	ScheduleSnapshotPublish();
+}
+
+void UOBGridItemState::ScheduleSnapshotPublish()
+{
+	if (!SnapshotPublishHandle.IsValid())
+	{
+		SnapshotPublishHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UOBGridItemState::PublishScheduledSnapshot));
+	}
+}
+
+bool UOBGridItemState::PublishScheduledSnapshot(float DeltaTime)
+{
+	SnapshotPublishHandle.Reset();
+	PublishSnapshot();
+	return false;
+}
+
+void UOBGridItemState::BuildSnapshot(FOBGridSnapshot& Snapshot)
+{
+	Snapshot.Version = ChangeJournal.GetLatestSequence();
+	Snapshot.Occupancy = Occupancy;
+	Snapshot.Items.Reserve(Items.Num());
+	Snapshot.ItemIndices.Reserve(Items.Num());
+	for (const TPair<int32, FOBGridItemInfo>& Pair : Items)
+	{
+		const FOBGridItemInfo& ItemInfo = Pair.Value;
+
+		// Interned payloads are already shared. Others are copied once per payload change, then shared with
+		// the earlier snapshots.
+		FConstSharedStruct Payload = ItemInfo.SharedPayload;
+		if (!Payload.IsValid() && ItemInfo.ItemPayload.IsValid())
+		{
+			FConstSharedStruct& CachedPayload = SnapshotPayloads.FindOrAdd(Pair.Key);
+			if (!CachedPayload.IsValid())
+			{
+				CachedPayload = FSharedStruct::Make(ItemInfo.ItemPayload.GetScriptStruct(),
+													ItemInfo.ItemPayload.GetMemory());
+			}
+			Payload = CachedPayload;
+		}
+
+		Snapshot.ItemIndices.Add(Pair.Key, Snapshot.Items.Num());
+		FOBGridSnapshotItem& SnapshotItem = Snapshot.Items.AddDefaulted_GetRef();
+		SnapshotItem.ItemId = Pair.Key;
+		SnapshotItem.Row = ItemInfo.Row;
+		SnapshotItem.Column = ItemInfo.Column;
+		SnapshotItem.RowSpan = ItemInfo.RowSpan;
+		SnapshotItem.ColumnSpan = ItemInfo.ColumnSpan;
+		SnapshotItem.Payload = Payload;
+	}
+}
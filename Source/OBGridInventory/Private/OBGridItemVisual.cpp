@@ -0,0 +1,10 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridItemVisual.h"
+
+#include "Styling/CoreStyle.h"
+
+FOBGridPaintedItemStyle::FOBGridPaintedItemStyle()
+{
+	QuantityFont = FCoreStyle::GetDefaultFontStyle("Bold", 10);
+}
@@ -0,0 +1,154 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridMemoryStats.h"
+
+#include "OBGridInventoryWidget.h"
+#include "OBGridItemState.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
+#include "UObject/UObjectIterator.h"
+
+namespace OBGridMemory
+{
+	static const TCHAR* DumpCommandName = TEXT("OB.Grid.DumpMemory");
+
+	int64 GetObjectBytes(const UObject* Object)
+	{
+		if (!Object) return 0;
+		FArchiveCountMem CountMem(Object);
+		return static_cast<int64>(CountMem.GetMax());
+	}
+
+	int64 GetPayloadHeapBytes(const FConstStructView Payload)
+	{
+		const UScriptStruct* ScriptStruct = Payload.GetScriptStruct();
+		const uint8* Memory = Payload.GetMemory();
+		if (!ScriptStruct || !Memory) return 0;
+
+		int64 Bytes = ScriptStruct->GetStructureSize();
+		for (TFieldIterator<FProperty> It(ScriptStruct); It; ++It)
+		{
+			if (const FStrProperty* StrProperty = CastField<FStrProperty>(*It))
+			{
+				Bytes += StrProperty->GetPropertyValue_InContainer(Memory).GetAllocatedSize();
+			}
+			else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(*It))
+			{
+				FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(Memory));
+				Bytes += static_cast<int64>(ArrayHelper.Num()) * ArrayProperty->Inner->GetSize();
+			}
+		}
+		return Bytes;
+	}
+
+	void AddItemStateStats(const UOBGridItemState& State, FOBGridMemoryStats& InOutStats)
+	{
+		InOutStats.NumItems += State.GetNumItems();
+		InOutStats.ItemMapBytes += State.GetItemMapAllocatedSize();
+		InOutStats.BookkeepingBytes += State.GetOccupancy().GetAllocatedSize() +
+			State.GetChangeJournal().GetAllocatedSize();
+
+		// Interned payloads are counted once per shared instance.
+		TSet<const uint8*> CountedSharedPayloads;
+		for (const TPair<int32, FOBGridItemInfo>& Pair : State.GetItems())
+		{
+			const FOBGridItemInfo& Info = Pair.Value;
+			if (!Info.SharedPayload.IsValid())
+			{
+				InOutStats.PayloadHeapBytes += GetPayloadHeapBytes(Info.ItemPayload);
+			}
+			else if (!CountedSharedPayloads.Contains(Info.SharedPayload.GetMemory()))
+			{
+				CountedSharedPayloads.Add(Info.SharedPayload.GetMemory());
+				InOutStats.PayloadHeapBytes += GetPayloadHeapBytes(Info.GetPayload());
+			}
+		}
+	}
+
+	int64 GetWidgetBytes(const UUserWidget* Widget)
+	{
+		if (!Widget) return 0;
+
+		int64 Bytes = GetObjectBytes(Widget);
+		if (const UWidgetTree* WidgetTree = Widget->WidgetTree)
+		{
+			Bytes += GetObjectBytes(WidgetTree);
+			WidgetTree->ForEachWidget([&Bytes](const UWidget* Child)
+			{
+				Bytes += GetObjectBytes(Child);
+			});
+		}
+		return Bytes;
+	}
+
+	void LogStatsRow(FOutputDevice& Ar, const FString& Name, const FOBGridMemoryStats& Stats)
+	{
+		Ar.Logf(TEXT("%-48s %6d %6d %6d %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f"), *Name, Stats.NumItems,
+				Stats.NumItemWidgets, Stats.NumDummyWidgets, Stats.ItemWidgetBytes / 1024.0,
+				Stats.DummyWidgetBytes / 1024.0, Stats.ItemMapBytes / 1024.0, Stats.DummyMapBytes / 1024.0,
+				Stats.PayloadHeapBytes / 1024.0, Stats.BookkeepingBytes / 1024.0, Stats.GetTotalBytes() / 1024.0);
+	}
+
+	void DumpAllGrids(FOutputDevice& Ar)
+	{
+		Ar.Logf(TEXT("OBGridInventory memory (KB):"));
+		Ar.Logf(TEXT("%-48s %6s %6s %6s %10s %10s %10s %10s %10s %10s %10s"), TEXT("Grid"), TEXT("Items"),
+				TEXT("ItemW"), TEXT("Dummy"), TEXT("ItemWdg"), TEXT("DummyWdg"), TEXT("ItemMap"), TEXT("DummyMap"),
+				TEXT("Payload"), TEXT("Books"), TEXT("Total"));
+
+		// Each item state is counted once, with the first view dumped, whoever created it.
+		FOBGridMemoryStats Totals;
+		TSet<const UOBGridItemState*> CountedStates;
+		int32 NumGrids = 0;
+		for (TObjectIterator<UOBGridInventoryWidget> It; It; ++It)
+		{
+			const UOBGridInventoryWidget* Grid = *It;
+			if (!Grid || Grid->IsTemplate() || !IsValid(Grid)) continue;
+
+			bool bStateCounted = false;
+			CountedStates.Add(Grid->GetItemState(), &bStateCounted);
+			const FOBGridMemoryStats Stats = Grid->GetMemoryStats(!bStateCounted);
+			Totals += Stats;
+			++NumGrids;
+			LogStatsRow(Ar, Grid->GetPathName(), Stats);
+		}
+
+		// States without any view (server-side stashes, views not created yet).
+		for (TObjectIterator<UOBGridItemState> It; It; ++It)
+		{
+			const UOBGridItemState* State = *It;
+			if (!State || State->IsTemplate() || !IsValid(State) || CountedStates.Contains(State)) continue;
+
+			FOBGridMemoryStats Stats;
+			AddItemStateStats(*State, Stats);
+			Totals += Stats;
+			LogStatsRow(Ar, State->GetPathName(), Stats);
+		}
+
+		Ar.Logf(TEXT("%d grid(s), %d item(s), %d item widget(s), %d dummy widget(s), %.1f KB total"), NumGrids,
+				Totals.NumItems, Totals.NumItemWidgets, Totals.NumDummyWidgets, Totals.GetTotalBytes() / 1024.0);
+	}
+
+	static FAutoConsoleCommandWithOutputDevice GDumpGridMemoryCommand(
+		DumpCommandName,
+		TEXT("Dumps the memory used by every live OBGridInventory widget (widgets, maps, payloads)."),
+		FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&DumpAllGrids));
+}
+
+FOBGridMemoryStats& FOBGridMemoryStats::operator+=(const FOBGridMemoryStats& Other)
+{
+	NumItems += Other.NumItems;
+	NumItemWidgets += Other.NumItemWidgets;
+	NumDummyWidgets += Other.NumDummyWidgets;
+	ItemWidgetBytes += Other.ItemWidgetBytes;
+	DummyWidgetBytes += Other.DummyWidgetBytes;
+	ItemMapBytes += Other.ItemMapBytes;
+	DummyMapBytes += Other.DummyMapBytes;
+	PayloadHeapBytes += Other.PayloadHeapBytes;
+	BookkeepingBytes += Other.BookkeepingBytes;
+	return *this;
+}
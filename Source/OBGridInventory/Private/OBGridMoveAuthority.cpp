@@ -0,0 +1,91 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridMoveAuthority.h"
+
+#include "OBGridItemState.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarOBGridSimulatedLatency(
+	TEXT("OB.Grid.SimulatedLatency"), -1.0f,
+	TEXT("Round trip, in seconds, of every simulated grid move authority. Negative uses each one's own setting."));
+
+void UOBGridMoveAuthority::RequestMove_Implementation(UOBGridItemState* State, const int32 ReservationId,
+													  const int32 ItemId, const int32 NewRowTopLeft,
+													  const int32 NewColTopLeft)
+{
+	// Nobody to ask: keep the move.
+	if (State)
+	{
+		State->ConfirmReservation(ReservationId);
+	}
+}
+
+// --- Simulated ---
+
+void UOBGridSimulatedMoveAuthority::RequestMove_Implementation(UOBGridItemState* State, const int32 ReservationId,
+															   const int32 ItemId, const int32 NewRowTopLeft,
+															   const int32 NewColTopLeft)
+{
+	if (!State) return;
+
+	const float OverrideLatency = CVarOBGridSimulatedLatency.GetValueOnGameThread();
+	const double Latency = (OverrideLatency >= 0.0f ? OverrideLatency : LatencySeconds) +
+		FMath::FRandRange(0.0f, JitterSeconds);
+
+	// Never answer before an earlier request.
+	const double Now = FPlatformTime::Seconds();
+	FPendingRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.State = State;
+	Request.ReservationId = ReservationId;
+	Request.DueSeconds = PendingRequests.Num() > 1
+		? FMath::Max(Now + Latency, PendingRequests[PendingRequests.Num() - 2].DueSeconds)
+		: Now + Latency;
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UOBGridSimulatedMoveAuthority::ResolveDueRequests));
+	}
+}
+
+void UOBGridSimulatedMoveAuthority::BeginDestroy()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
+
+bool UOBGridSimulatedMoveAuthority::ResolveDueRequests(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	int32 NumResolved = 0;
+	for (; NumResolved < PendingRequests.Num() && PendingRequests[NumResolved].DueSeconds <= Now; ++NumResolved)
+	{
+		// Copied: listeners of the state may request another move, which can reallocate the queue.
+		const FPendingRequest Request = PendingRequests[NumResolved];
+		UOBGridItemState* State = Request.State.Get();
+		if (!State) continue;
+
+		if (FMath::FRand() < RejectionChance)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Simulated server refused reservation %d."),
+				   *GetNameSafe(this), __FUNCTION__, Request.ReservationId);
+			State->RollbackReservation(Request.ReservationId);
+		}
+		else
+		{
+			State->ConfirmReservation(Request.ReservationId);
+		}
+	}
+	PendingRequests.RemoveAt(0, NumResolved);
+
+	if (PendingRequests.IsEmpty())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,197 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridOccupancy.h"
+
+void FOBGridOccupancy::Reset(const int32 InNumRows, const int32 InNumColumns)
+{
+	NumRows = FMath::Max(InNumRows, 0);
+	NumColumns = FMath::Max(InNumColumns, 0);
+	Cells.Init(FreeCell, NumRows * NumColumns);
+	CellSections.Reset();
+}
+
+void FOBGridOccupancy::Resize(const int32 InNumRows, const int32 InNumColumns)
+{
+	const int32 NewNumRows = FMath::Max(InNumRows, 0);
+	const int32 NewNumColumns = FMath::Max(InNumColumns, 0);
+	if (NewNumRows == NumRows && NewNumColumns == NumColumns) return;
+
+	TArray<int32> NewCells;
+	NewCells.Init(FreeCell, NewNumRows * NewNumColumns);
+	const int32 KeptRows = FMath::Min(NumRows, NewNumRows);
+	const int32 KeptColumns = FMath::Min(NumColumns, NewNumColumns);
+	for (int32 r = 0; r < KeptRows; ++r)
+	{
+		FMemory::Memcpy(NewCells.GetData() + r * NewNumColumns, Cells.GetData() + r * NumColumns,
+						KeptColumns * sizeof(int32));
+	}
+
+	NumRows = NewNumRows;
+	NumColumns = NewNumColumns;
+	Cells = MoveTemp(NewCells);
+	CellSections.Reset();
+}
+
+void FOBGridOccupancy::SetCellSections(TArray<int32> InCellSections)
+{
+	CellSections = InCellSections.Num() == Cells.Num() ? MoveTemp(InCellSections) : TArray<int32>();
+}
+
+bool FOBGridOccupancy::IsAreaClear(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows,
+								   const int32 ItemCols, const int32 IgnoredItemId, const FIntRect& HeldArea) const
+{
+	if (!IsInBounds(TopLeftRow, TopLeftCol, ItemRows, ItemCols)) return false;
+
+	const int32 Section = GetCellSection(TopLeftRow, TopLeftCol);
+	if (Section == INDEX_NONE) return false;
+
+	for (int32 r = TopLeftRow; r < TopLeftRow + ItemRows; ++r)
+	{
+		const int32* RowCells = Cells.GetData() + r * NumColumns;
+		const int32* RowSections = CellSections.IsEmpty() ? nullptr : CellSections.GetData() + r * NumColumns;
+		for (int32 c = TopLeftCol; c < TopLeftCol + ItemCols; ++c)
+		{
+			if (const int32 Owner = RowCells[c]; Owner != FreeCell && Owner != IgnoredItemId &&
+				(Owner != ReservedCell || !HeldArea.Contains(FIntPoint(c, r))))
+			{
+				return false;
+			}
+			if (RowSections && RowSections[c] != Section)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool FOBGridOccupancy::FindFreeSlot(const int32 ItemRows, const int32 ItemCols, int32& OutRow, int32& OutCol,
+								   const int32 SectionIndex) const
+{
+	if (ItemRows < 1 || ItemCols < 1 || NumRows < ItemRows || NumColumns < ItemCols) return false;
+
+	for (int32 TestRow = 0; TestRow <= NumRows - ItemRows; ++TestRow)
+	{
+		for (int32 TestCol = 0; TestCol <= NumColumns - ItemCols; ++TestCol)
+		{
+			if (SectionIndex != INDEX_NONE && GetCellSection(TestRow, TestCol) != SectionIndex) continue;
+			if (IsAreaClear(TestRow, TestCol, ItemRows, ItemCols))
+			{
+				OutRow = TestRow;
+				OutCol = TestCol;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void FOBGridOccupancy::Fill(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows,
+							const int32 ItemCols, const int32 ItemId)
+{
+	const int32 RowBegin = FMath::Max(TopLeftRow, 0);
+	const int32 RowEnd = FMath::Min(TopLeftRow + ItemRows, NumRows);
+	const int32 ColBegin = FMath::Max(TopLeftCol, 0);
+	const int32 ColEnd = FMath::Min(TopLeftCol + ItemCols, NumColumns);
+	for (int32 r = RowBegin; r < RowEnd; ++r)
+	{
+		for (int32 c = ColBegin; c < ColEnd; ++c)
+		{
+			Cells[r * NumColumns + c] = ItemId;
+		}
+	}
+}
+
+int32 FOBGridOccupancy::Replace(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows,
+								const int32 ItemCols, const int32 OldValue, const int32 NewValue)
+{
+	int32 NumReplaced = 0;
+	const int32 RowEnd = FMath::Min(TopLeftRow + ItemRows, NumRows);
+	const int32 ColEnd = FMath::Min(TopLeftCol + ItemCols, NumColumns);
+	for (int32 r = FMath::Max(TopLeftRow, 0); r < RowEnd; ++r)
+	{
+		for (int32 c = FMath::Max(TopLeftCol, 0); c < ColEnd; ++c)
+		{
+			if (int32& Cell = Cells[r * NumColumns + c]; Cell == OldValue)
+			{
+				Cell = NewValue;
+				++NumReplaced;
+			}
+		}
+	}
+	return NumReplaced;
+}
+
+int32 FOBGridOccupancy::CountFreeCells() const
+{
+	int32 FreeCount = 0;
+	for (int32 Index = 0; Index < Cells.Num(); ++Index)
+	{
+		const bool bEnabled = CellSections.IsEmpty() || CellSections[Index] != INDEX_NONE;
+		FreeCount += bEnabled && Cells[Index] == FreeCell ? 1 : 0;
+	}
+	return FreeCount;
+}
+
+FIntRect FOBGridOccupancy::FindLargestFreeRect() const
+{
+	FIntRect BestRect;
+	int64 BestArea = 0;
+
+	// Row by row, Heights holds the free cells stacked above each column within the column's section; the best
+	// rectangle ending on a row is then the largest rectangle of each same-section run of that histogram.
+	TArray<int32> Heights;
+	Heights.SetNumZeroed(NumColumns);
+	TArray<int32> Stack;
+	Stack.Reserve(NumColumns + 1);
+
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		for (int32 Col = 0; Col < NumColumns; ++Col)
+		{
+			const int32 Section = GetCellSection(Row, Col);
+			if (Section == INDEX_NONE || Cells[Row * NumColumns + Col] != FreeCell)
+			{
+				Heights[Col] = 0;
+			}
+			else
+			{
+				Heights[Col] = GetCellSection(Row - 1, Col) == Section ? Heights[Col] + 1 : 1;
+			}
+		}
+
+		int32 RunStart = 0;
+		while (RunStart < NumColumns)
+		{
+			const int32 RunSection = Heights[RunStart] > 0 ? GetCellSection(Row, RunStart) : INDEX_NONE;
+			int32 RunEnd = RunStart + 1;
+			while (RunSection != INDEX_NONE && RunEnd < NumColumns && Heights[RunEnd] > 0 &&
+				GetCellSection(Row, RunEnd) == RunSection)
+			{
+				++RunEnd;
+			}
+
+			if (RunSection != INDEX_NONE)
+			{
+				Stack.Reset();
+				for (int32 Col = RunStart; Col <= RunEnd; ++Col)
+				{
+					const int32 Height = Col < RunEnd ? Heights[Col] : 0;
+					while (!Stack.IsEmpty() && Heights[Stack.Last()] >= Height)
+					{
+						const int32 Top = Stack.Pop(EAllowShrinking::No);
+						const int32 Left = Stack.IsEmpty() ? RunStart : Stack.Last() + 1;
+						if (const int64 Area = static_cast<int64>(Heights[Top]) * (Col - Left); Area > BestArea)
+						{
+							BestArea = Area;
+							BestRect = FIntRect(Left, Row - Heights[Top] + 1, Col, Row + 1);
+						}
+					}
+					Stack.Push(Col);
+				}
+			}
+			RunStart = RunEnd;
+		}
+	}
+	return BestRect;
+}
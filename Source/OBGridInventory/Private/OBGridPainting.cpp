@@ -0,0 +1,165 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridPainting.h"
+
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Layout/Geometry.h"
+#include "Rendering/DrawElements.h"
+#include "Rendering/SlateRenderer.h"
+
+namespace OBGridPainting
+{
+	enum class EEdgeType : uint8 { None, Grid, Border };
+
+	void PaintGridLines(const FGridLineParams& Params, const FGeometry& AllottedGeometry,
+						FSlateWindowElementList& OutDrawElements, const int32 LayerId)
+	{
+		if (Params.NumRows <= 0 || Params.NumColumns <= 0 || Params.ScaledCellSize <= KINDA_SMALL_NUMBER) return;
+		if (Params.GridLineColor.A <= 0 && Params.BorderLineColor.A <= 0) return;
+
+		const bool bHasLayout = Params.CellSections.Num() == Params.NumRows * Params.NumColumns;
+		auto GetCellSection = [&Params, bHasLayout](const int32 Row, const int32 Column)
+		{
+			if (Row < 0 || Row >= Params.NumRows || Column < 0 || Column >= Params.NumColumns) return INDEX_NONE;
+			return bHasLayout ? Params.CellSections[Row * Params.NumColumns + Column] : 0;
+		};
+
+		// An edge between two cells is a grid line inside a section, a border between a usable cell and anything
+		// else (outside, masked, another section) and nothing between two unusable cells.
+		auto ClassifyEdge = [&GetCellSection](const int32 RowA, const int32 ColA, const int32 RowB, const int32 ColB)
+		{
+			const int32 SectionA = GetCellSection(RowA, ColA);
+			const int32 SectionB = GetCellSection(RowB, ColB);
+			if (SectionA == INDEX_NONE && SectionB == INDEX_NONE) return EEdgeType::None;
+			return SectionA == SectionB ? EEdgeType::Grid : EEdgeType::Border;
+		};
+
+		const FPaintGeometry PaintGeometry = AllottedGeometry.ToPaintGeometry();
+		TArray<FVector2D> LinePoints;
+		LinePoints.SetNumUninitialized(2);
+
+		auto DrawRun = [&](const FVector2D& Start, const FVector2D& End, const EEdgeType Type)
+		{
+			if (Type == EEdgeType::None) return;
+			const bool bIsBorder = Type == EEdgeType::Border;
+			const float CurrentThickness = bIsBorder ? Params.BorderLineThickness : Params.GridLineThickness;
+			if (const FLinearColor& CurrentColor = bIsBorder ? Params.BorderLineColor : Params.GridLineColor;
+				CurrentThickness > 0 && CurrentColor.A > 0)
+			{
+				LinePoints[0] = Start;
+				LinePoints[1] = End;
+				FSlateDrawElement::MakeLines(OutDrawElements, LayerId, PaintGeometry, LinePoints,
+											 ESlateDrawEffect::None, CurrentColor, false, CurrentThickness);
+			}
+		};
+
+		const float CellSize = Params.ScaledCellSize;
+
+		// --- Vertical lines & borders ---
+		for (int32 X = 0; X <= Params.NumColumns; ++X)
+		{
+			const float LineX = X * CellSize;
+			int32 RunStart = 0;
+			EEdgeType RunType = ClassifyEdge(0, X - 1, 0, X);
+			for (int32 Y = 1; Y <= Params.NumRows; ++Y)
+			{
+				const EEdgeType Type = Y < Params.NumRows ? ClassifyEdge(Y, X - 1, Y, X) : EEdgeType::None;
+				if (Y == Params.NumRows || Type != RunType)
+				{
+					DrawRun(FVector2D(LineX, RunStart * CellSize), FVector2D(LineX, Y * CellSize), RunType);
+					RunStart = Y;
+					RunType = Type;
+				}
+			}
+		}
+
+		// --- Horizontal lines & borders ---
+		for (int32 Y = 0; Y <= Params.NumRows; ++Y)
+		{
+			const float LineY = Y * CellSize;
+			int32 RunStart = 0;
+			EEdgeType RunType = ClassifyEdge(Y - 1, 0, Y, 0);
+			for (int32 X = 1; X <= Params.NumColumns; ++X)
+			{
+				const EEdgeType Type = X < Params.NumColumns ? ClassifyEdge(Y - 1, X, Y, X) : EEdgeType::None;
+				if (X == Params.NumColumns || Type != RunType)
+				{
+					DrawRun(FVector2D(RunStart * CellSize, LineY), FVector2D(X * CellSize, LineY), RunType);
+					RunStart = X;
+					RunType = Type;
+				}
+			}
+		}
+	}
+
+	void PaintItems(const TMap<int32, FOBGridPaintedItem>& Items, const FOBGridPaintedItemStyle& Style,
+					const float ScaledCellSize, const float GridScale, const FGeometry& AllottedGeometry,
+					const FSlateRect& CullingRect, FSlateWindowElementList& OutDrawElements, const int32 LayerId)
+	{
+		if (Items.IsEmpty() || ScaledCellSize <= KINDA_SMALL_NUMBER) return;
+
+		const float IconPadding = Style.IconPadding * GridScale;
+		const float QuantityPadding = Style.QuantityPadding * GridScale;
+		const float BorderThickness = FMath::Max(1.0f, Style.BorderThickness * GridScale);
+		FSlateFontInfo QuantityFont = Style.QuantityFont;
+		QuantityFont.Size = FMath::Max(1.0f, QuantityFont.Size * GridScale);
+		const TSharedRef<FSlateFontMeasure> FontMeasure =
+			FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+
+		TArray<FVector2D> FramePoints;
+		FramePoints.SetNumUninitialized(5);
+
+		for (const TPair<int32, FOBGridPaintedItem>& Pair : Items)
+		{
+			const FOBGridPaintedItem& Item = Pair.Value;
+			if (Item.bHidden) continue;
+
+			const FVector2D Offset(Item.Column * ScaledCellSize, Item.Row * ScaledCellSize);
+			const FVector2D Size(Item.ColumnSpan * ScaledCellSize, Item.RowSpan * ScaledCellSize);
+			const FSlateRect ItemRect = TransformRect(AllottedGeometry.GetAccumulatedRenderTransform(),
+													  FSlateRect(Offset, Offset + Size));
+			if (!FSlateRect::DoRectanglesIntersect(ItemRect, CullingRect)) continue;
+
+			const FOBGridItemVisual& Visual = Item.Visual;
+			if (Visual.BackgroundColor.A > 0)
+			{
+				FSlateDrawElement::MakeBox(OutDrawElements, LayerId,
+										   AllottedGeometry.ToPaintGeometry(Size, FSlateLayoutTransform(Offset)),
+										   &Style.BackgroundBrush, ESlateDrawEffect::None, Visual.BackgroundColor);
+			}
+
+			if (Visual.Icon.DrawAs != ESlateBrushDrawType::NoDrawType)
+			{
+				const FVector2D IconSize = (Size - FVector2D(IconPadding * 2.0f)).ComponentMax(FVector2D::ZeroVector);
+				FSlateDrawElement::MakeBox(OutDrawElements, LayerId,
+										   AllottedGeometry.ToPaintGeometry(
+											   IconSize, FSlateLayoutTransform(Offset + FVector2D(IconPadding))),
+										   &Visual.Icon, ESlateDrawEffect::None, Visual.Icon.GetTint(FWidgetStyle()));
+			}
+
+			if (Visual.BorderColor.A > 0)
+			{
+				const float Inset = BorderThickness * 0.5f;
+				FramePoints[0] = Offset + FVector2D(Inset, Inset);
+				FramePoints[1] = Offset + FVector2D(Size.X - Inset, Inset);
+				FramePoints[2] = Offset + FVector2D(Size.X - Inset, Size.Y - Inset);
+				FramePoints[3] = Offset + FVector2D(Inset, Size.Y - Inset);
+				FramePoints[4] = FramePoints[0];
+				FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), FramePoints,
+											 ESlateDrawEffect::None, Visual.BorderColor, false, BorderThickness);
+			}
+
+			if (!Visual.QuantityText.IsEmpty())
+			{
+				const FString QuantityString = Visual.QuantityText.ToString();
+				const FVector2D TextSize = FontMeasure->Measure(QuantityString, QuantityFont);
+				const FVector2D TextOffset = Offset + Size - TextSize - FVector2D(QuantityPadding);
+				const FPaintGeometry TextGeometry =
+					AllottedGeometry.ToPaintGeometry(TextSize, FSlateLayoutTransform(TextOffset));
+				FSlateDrawElement::MakeText(OutDrawElements, LayerId + 1, TextGeometry, QuantityString, QuantityFont,
+											ESlateDrawEffect::None, Style.QuantityColor);
+			}
+		}
+	}
+}
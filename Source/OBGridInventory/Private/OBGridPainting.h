@@ -0,0 +1,42 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBGridItemVisual.h"
+
+class FSlateRect;
+class FSlateWindowElementList;
+struct FGeometry;
+
+namespace OBGridPainting
+{
+	/** Everything needed to draw grid lines; thicknesses are already scaled. */
+	struct FGridLineParams
+	{
+		int32 NumRows = 0;
+		int32 NumColumns = 0;
+		float ScaledCellSize = 0.0f;
+		float GridLineThickness = 1.0f;
+		float BorderLineThickness = 1.0f;
+		FLinearColor GridLineColor = FLinearColor::Transparent;
+		FLinearColor BorderLineColor = FLinearColor::Transparent;
+		/** Row-major section index per cell (INDEX_NONE = masked). Empty for a plain rectangular grid. */
+		TConstArrayView<int32> CellSections;
+	};
+
+	/**
+	 * Draws grid lines inside sections and borders around them on a single layer.
+	 * Consecutive edges of the same type are merged, so a plain grid costs one line per row/column.
+	 */
+	void PaintGridLines(const FGridLineParams& Params, const FGeometry& AllottedGeometry,
+						FSlateWindowElementList& OutDrawElements, int32 LayerId);
+
+	/**
+	 * Draws painted items (background, icon, frame, quantity) on two layers: boxes on LayerId, text on LayerId + 1.
+	 * Hidden items and items outside the culling rect are skipped.
+	 */
+	void PaintItems(const TMap<int32, FOBGridPaintedItem>& Items, const FOBGridPaintedItemStyle& Style,
+					float ScaledCellSize, float GridScale, const FGeometry& AllottedGeometry,
+					const FSlateRect& CullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId);
+}
@@ -0,0 +1,173 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridPanel.h"
+
+#include "OBGridPanelSlot.h"
+#include "SOBGridPanel.h"
+
+#define LOCTEXT_NAMESPACE "OBGridInventory"
+
+UOBGridPanel::UOBGridPanel()
+{
+	bIsVariable = true;
+	SetVisibilityInternal(ESlateVisibility::SelfHitTestInvisible);
+}
+
+UOBGridPanelSlot* UOBGridPanel::AddChildToCell(UWidget* Content, const int32 Row, const int32 Column,
+											   const int32 RowSpan, const int32 ColumnSpan)
+{
+	UOBGridPanelSlot* GridSlot = Cast<UOBGridPanelSlot>(Super::AddChild(Content));
+	if (GridSlot)
+	{
+		GridSlot->SetCell(Row, Column);
+		GridSlot->SetSpan(RowSpan, ColumnSpan);
+	}
+	return GridSlot;
+}
+
+void UOBGridPanel::SetGridConfig(const FOBGridInventoryConfig& InGridConfig)
+{
+	GridConfig = InGridConfig;
+	if (MyGridPanel.IsValid())
+	{
+		SynchronizeProperties();
+	}
+}
+
+void UOBGridPanel::SetGridScale(const float InGridScale)
+{
+	GridScale = FMath::Max(InGridScale, KINDA_SMALL_NUMBER);
+	if (MyGridPanel.IsValid())
+	{
+		MyGridPanel->SetGridScale(GridScale);
+	}
+}
+
+void UOBGridPanel::SetPaintedItem(const int32 ItemId, const FOBGridPaintedItem& Item)
+{
+	PaintedItems.Add(ItemId, Item);
+	PushPaintedItem(ItemId);
+}
+
+void UOBGridPanel::SetPaintedItemCell(const int32 ItemId, const int32 Row, const int32 Column)
+{
+	if (FOBGridPaintedItem* Item = PaintedItems.Find(ItemId))
+	{
+		Item->Row = Row;
+		Item->Column = Column;
+		PushPaintedItem(ItemId);
+	}
+}
+
+void UOBGridPanel::SetPaintedItemHidden(const int32 ItemId, const bool bHidden)
+{
+	if (FOBGridPaintedItem* Item = PaintedItems.Find(ItemId); Item && Item->bHidden != bHidden)
+	{
+		Item->bHidden = bHidden;
+		PushPaintedItem(ItemId);
+	}
+}
+
+void UOBGridPanel::RemovePaintedItem(const int32 ItemId)
+{
+	PaintedItems.Remove(ItemId);
+	if (MyGridPanel.IsValid())
+	{
+		MyGridPanel->RemovePaintedItem(ItemId);
+	}
+}
+
+void UOBGridPanel::ClearPaintedItems()
+{
+	PaintedItems.Empty();
+	if (MyGridPanel.IsValid())
+	{
+		MyGridPanel->ClearPaintedItems();
+	}
+}
+
+void UOBGridPanel::PushPaintedItem(const int32 ItemId) const
+{
+	if (MyGridPanel.IsValid())
+	{
+		MyGridPanel->SetPaintedItem(ItemId, PaintedItems.FindChecked(ItemId));
+	}
+}
+
+void UOBGridPanel::SynchronizeProperties()
+{
+	Super::SynchronizeProperties();
+	if (!MyGridPanel.IsValid()) return;
+
+	MyGridPanel->SetGridSize(GridConfig.NumRows, GridConfig.NumColumns);
+	MyGridPanel->SetCellSize(GridConfig.CellSize);
+	MyGridPanel->SetGridScale(GridScale);
+	MyGridPanel->SetGridLines(bDrawGridLines, GridConfig.GridLineColor, GridConfig.GridLineThickness,
+							  GridConfig.BorderLineColor, GridConfig.BorderLineThickness);
+	MyGridPanel->SetPaintedItemStyle(PaintedItemStyle);
+
+	TArray<int32> CellSections;
+	GridConfig.BuildCellSections(GridConfig.NumRows, GridConfig.NumColumns, CellSections);
+	MyGridPanel->SetCellSections(MoveTemp(CellSections));
+}
+
+void UOBGridPanel::ReleaseSlateResources(const bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+	MyGridPanel.Reset();
+}
+
+#if WITH_EDITOR
+const FText UOBGridPanel::GetPaletteCategory()
+{
+	return LOCTEXT("OBGridInventory", "OB Grid Inventory");
+}
+#endif
+
+UClass* UOBGridPanel::GetSlotClass() const
+{
+	return UOBGridPanelSlot::StaticClass();
+}
+
+void UOBGridPanel::OnSlotAdded(UPanelSlot* InSlot)
+{
+	if (MyGridPanel.IsValid())
+	{
+		CastChecked<UOBGridPanelSlot>(InSlot)->BuildSlot(MyGridPanel.ToSharedRef());
+	}
+}
+
+void UOBGridPanel::OnSlotRemoved(UPanelSlot* InSlot)
+{
+	if (MyGridPanel.IsValid() && InSlot->Content)
+	{
+		if (const TSharedPtr<SWidget> Widget = InSlot->Content->GetCachedWidget(); Widget.IsValid())
+		{
+			MyGridPanel->RemoveSlot(Widget.ToSharedRef());
+		}
+	}
+}
+
+TSharedRef<SWidget> UOBGridPanel::RebuildWidget()
+{
+	MyGridPanel = SNew(SOBGridPanel)
+		.NumRows(GridConfig.NumRows)
+		.NumColumns(GridConfig.NumColumns)
+		.CellSize(GridConfig.CellSize);
+
+	for (UPanelSlot* PanelSlot : Slots)
+	{
+		if (UOBGridPanelSlot* TypedSlot = Cast<UOBGridPanelSlot>(PanelSlot))
+		{
+			TypedSlot->Parent = this;
+			TypedSlot->BuildSlot(MyGridPanel.ToSharedRef());
+		}
+	}
+	for (const TPair<int32, FOBGridPaintedItem>& Pair : PaintedItems)
+	{
+		MyGridPanel->SetPaintedItem(Pair.Key, Pair.Value);
+	}
+	return MyGridPanel.ToSharedRef();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,46 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridPanelSlot.h"
+
+#include "Components/Widget.h"
+
+void UOBGridPanelSlot::SetCell(const int32 InRow, const int32 InColumn)
+{
+	Row = FMath::Max(InRow, 0);
+	Column = FMath::Max(InColumn, 0);
+	if (Slot)
+	{
+		Slot->SetCell(Row, Column);
+	}
+}
+
+void UOBGridPanelSlot::SetSpan(const int32 InRowSpan, const int32 InColumnSpan)
+{
+	RowSpan = FMath::Max(InRowSpan, 1);
+	ColumnSpan = FMath::Max(InColumnSpan, 1);
+	if (Slot)
+	{
+		Slot->SetSpan(RowSpan, ColumnSpan);
+	}
+}
+
+void UOBGridPanelSlot::BuildSlot(TSharedRef<SOBGridPanel> GridPanel)
+{
+	GridPanel->AddSlot(Row, Column, RowSpan, ColumnSpan)
+		.Expose(Slot)
+		[
+			Content == nullptr ? SNullWidget::NullWidget : Content->TakeWidget()
+		];
+}
+
+void UOBGridPanelSlot::SynchronizeProperties()
+{
+	SetCell(Row, Column);
+	SetSpan(RowSpan, ColumnSpan);
+}
+
+void UOBGridPanelSlot::ReleaseSlateResources(const bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+	Slot = nullptr;
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridPayloadPool.h"
+
+FConstSharedStruct FOBGridPayloadPool::Intern(const FConstStructView Payload)
+{
+	const UScriptStruct* ScriptStruct = Payload.GetScriptStruct();
+	const uint8* Memory = Payload.GetMemory();
+	if (!ScriptStruct || !Memory) return FConstSharedStruct();
+
+	TArray<FEntry, TInlineAllocator<1>>& Bucket = Buckets.FindOrAdd(HashPayload(ScriptStruct, Memory));
+	for (FEntry& Entry : Bucket)
+	{
+		if (Entry.Payload.GetScriptStruct() == ScriptStruct &&
+			ScriptStruct->CompareScriptStruct(Entry.Payload.GetMemory(), Memory, PPF_None))
+		{
+			++Entry.NumUsers;
+			return Entry.Payload;
+		}
+	}
+
+	FEntry& Entry = Bucket.AddDefaulted_GetRef();
+	Entry.Payload = FSharedStruct::Make(ScriptStruct, Memory);
+	Entry.NumUsers = 1;
+	++NumDistinct;
+	return Entry.Payload;
+}
+
+void FOBGridPayloadPool::Release(const FConstSharedStruct& Payload)
+{
+	const UScriptStruct* ScriptStruct = Payload.GetScriptStruct();
+	const uint8* Memory = Payload.GetMemory();
+	if (!ScriptStruct || !Memory) return;
+
+	// Interned instances are immutable, so their hash has not moved since Intern.
+	const uint32 Hash = HashPayload(ScriptStruct, Memory);
+	TArray<FEntry, TInlineAllocator<1>>* Bucket = Buckets.Find(Hash);
+	if (!Bucket) return;
+
+	const int32 EntryIndex = Bucket->IndexOfByPredicate([Memory](const FEntry& Entry)
+	{
+		return Entry.Payload.GetMemory() == Memory;
+	});
+	if (EntryIndex == INDEX_NONE || --(*Bucket)[EntryIndex].NumUsers > 0) return;
+
+	Bucket->RemoveAtSwap(EntryIndex);
+	--NumDistinct;
+	if (Bucket->IsEmpty())
+	{
+		Buckets.Remove(Hash);
+	}
+}
+
+void FOBGridPayloadPool::Empty()
+{
+	Buckets.Empty();
+	NumDistinct = 0;
+}
+
+SIZE_T FOBGridPayloadPool::GetAllocatedSize() const
+{
+	SIZE_T Bytes = Buckets.GetAllocatedSize();
+	for (const TPair<uint32, TArray<FEntry, TInlineAllocator<1>>>& Pair : Buckets)
+	{
+		Bytes += Pair.Value.GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+uint32 FOBGridPayloadPool::HashPayload(const UScriptStruct* ScriptStruct, const uint8* Memory)
+{
+	// Properties without a type hash (arrays, most nested structs) are left to CompareScriptStruct.
+	uint32 Hash = PointerHash(ScriptStruct);
+	for (TFieldIterator<FProperty> It(ScriptStruct); It; ++It)
+	{
+		if (!It->HasAnyPropertyFlags(CPF_HasGetValueTypeHash)) continue;
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+		{
+			Hash = HashCombineFast(Hash, It->GetValueTypeHash(It->ContainerPtrToValuePtr<void>(Memory, ArrayIndex)));
+		}
+	}
+	return Hash;
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridSnapshot.h"
+
+const FOBGridSnapshotItem* FOBGridSnapshot::FindItem(const int32 ItemId) const
+{
+	const int32* ItemIndex = ItemIndices.Find(ItemId);
+	return ItemIndex ? &Items[*ItemIndex] : nullptr;
+}
+
+int32 FOBGridSnapshot::GetItemIdAtCell(const int32 Row, const int32 Column) const
+{
+	const int32 ItemId = Occupancy.GetCell(Row, Column);
+	return ItemId > FOBGridOccupancy::FreeCell ? ItemId : INDEX_NONE;
+}
+
+SIZE_T FOBGridSnapshot::GetAllocatedSize() const
+{
+	return Occupancy.GetAllocatedSize() + Items.GetAllocatedSize() + ItemIndices.GetAllocatedSize();
+}
+
+FOBGridSnapshotPtr FOBGridSnapshotChannel::Acquire() const
+{
+	for (;;)
+	{
+		const int32 SlotIndex = LatestSlot.load();
+		if (SlotIndex == INDEX_NONE) return nullptr;
+
+		// The writer never touches the latest slot, nor a slot with readers; re-checking after pinning proves
+		// the slot was not picked for a publication in between.
+		const FSlot& Slot = Slots[SlotIndex];
+		Slot.NumReaders.fetch_add(1);
+		if (LatestSlot.load() == SlotIndex)
+		{
+			FOBGridSnapshotPtr Snapshot = Slot.Snapshot;
+			Slot.NumReaders.fetch_sub(1);
+			return Snapshot;
+		}
+		Slot.NumReaders.fetch_sub(1);
+	}
+}
+
+bool FOBGridSnapshotChannel::Publish(FOBGridSnapshotPtr Snapshot)
+{
+	check(IsInGameThread());
+	const int32 CurrentSlot = LatestSlot.load();
+	for (int32 Offset = 1; Offset <= NumSlots; ++Offset)
+	{
+		const int32 SlotIndex = (FMath::Max(CurrentSlot, 0) + Offset) % NumSlots;
+		if (SlotIndex == CurrentSlot || Slots[SlotIndex].NumReaders.load() != 0) continue;
+
+		// The snapshot this slot held before is released here unless a reader still holds a copy.
+		Slots[SlotIndex].Snapshot = MoveTemp(Snapshot);
+		LatestSlot.store(SlotIndex);
+		return true;
+	}
+	return false;
+}
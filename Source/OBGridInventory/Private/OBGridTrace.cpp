@@ -0,0 +1,746 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridTrace.h"
+
+#include "OBGridItemState.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "StructUtils/InstancedStruct.h"
+#include "UObject/Class.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace OBGridTrace
+{
+	static constexpr uint32 FileMagic = 0x5447424F; // "OBGT"
+	static constexpr uint32 FileVersion = 1;
+
+	/** Upper bound for array counts read from a file, so a damaged trace cannot request a huge allocation. */
+	static constexpr int32 MaxSerializedNum = 1 << 20;
+
+	enum class ERecordType : uint8 { Payload, Grid, Event };
+
+	/**
+	 * What each operation stores besides its grid size and timing:
+	 *   InitializeGrid      NumRows, NumColumns, layout
+	 *   ResizeGrid          NewRows, NewColumns, EOBGridResizePolicy
+	 *   SetGridLayout       layout
+	 *   AddItem             ItemRows, ItemCols, SectionIndex, payload, placed id
+	 *   AddItemAt           ItemRows, ItemCols, RowTopLeft, ColTopLeft, payload, placed id
+	 *   AddStackableItem    ItemRows, ItemCols, bAllowNewStacks, payload, placed ids
+	 *   RemoveItem          ItemId
+	 *   MoveItem            ItemId, NewRowTopLeft, NewColTopLeft
+	 *   SetItemPayload      ItemId, payload
+	 *   ClearGrid           -
+	 *   ReserveMove         ItemId, NewRowTopLeft, NewColTopLeft, reservation id
+	 *   ConfirmReservation  ReservationId
+	 *   RollbackReservation ReservationId
+	 */
+	struct FOpLayout
+	{
+		uint8 NumArgs;
+		bool bHasPayload;
+		bool bHasResults;
+		bool bHasLayout;
+	};
+
+	static constexpr FOpLayout OpLayouts[] = {
+		{2, false, false, true},
+		{3, false, false, false},
+		{0, false, false, true},
+		{3, true, true, false},
+		{4, true, true, false},
+		{3, true, true, false},
+		{1, false, false, false},
+		{3, false, false, false},
+		{1, true, false, false},
+		{0, false, false, false},
+		{3, false, true, false},
+		{1, false, false, false},
+		{1, false, false, false},
+	};
+	static_assert(UE_ARRAY_COUNT(OpLayouts) == static_cast<int32>(EOBGridTraceOp::Num), "One layout per operation.");
+
+	/** Zigzag then packed, so small values of either sign (INDEX_NONE included) take a single byte. */
+	void SerializeInt(FArchive& Ar, int32& Value)
+	{
+		uint32 Encoded = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+		Ar.SerializeIntPacked(Encoded);
+		if (Ar.IsLoading())
+		{
+			Value = static_cast<int32>(Encoded >> 1) ^ -static_cast<int32>(Encoded & 1);
+		}
+	}
+
+	bool SerializeNum(FArchive& Ar, int32& Num)
+	{
+		SerializeInt(Ar, Num);
+		if (Num < 0 || Num > MaxSerializedNum)
+		{
+			Ar.SetError();
+		}
+		return !Ar.IsError();
+	}
+
+	void SerializeLayout(FArchive& Ar, TArray<FOBGridSection>& Sections, TArray<FIntPoint>& DisabledCells)
+	{
+		int32 NumSections = Sections.Num();
+		if (!SerializeNum(Ar, NumSections)) return;
+		Sections.SetNum(NumSections);
+		for (FOBGridSection& Section : Sections)
+		{
+			FString SectionName = Section.SectionName.ToString();
+			Ar << SectionName;
+			Section.SectionName = FName(*SectionName);
+			SerializeInt(Ar, Section.Row);
+			SerializeInt(Ar, Section.Column);
+			SerializeInt(Ar, Section.NumRows);
+			SerializeInt(Ar, Section.NumColumns);
+		}
+
+		int32 NumDisabledCells = DisabledCells.Num();
+		if (!SerializeNum(Ar, NumDisabledCells)) return;
+		DisabledCells.SetNum(NumDisabledCells);
+		for (FIntPoint& Cell : DisabledCells)
+		{
+			SerializeInt(Ar, Cell.X);
+			SerializeInt(Ar, Cell.Y);
+		}
+	}
+
+	void SerializeGrid(FArchive& Ar, FOBGridTraceGrid& Grid)
+	{
+		Ar.SerializeIntPacked(Grid.GridKey);
+		SerializeInt(Ar, Grid.NumRows);
+		SerializeInt(Ar, Grid.NumColumns);
+		SerializeLayout(Ar, Grid.Sections, Grid.DisabledCells);
+
+		int32 NumItems = Grid.Items.Num();
+		if (!SerializeNum(Ar, NumItems)) return;
+		Grid.Items.SetNum(NumItems);
+		for (FOBGridTraceItem& Item : Grid.Items)
+		{
+			SerializeInt(Ar, Item.ItemId);
+			SerializeInt(Ar, Item.Row);
+			SerializeInt(Ar, Item.Column);
+			SerializeInt(Ar, Item.RowSpan);
+			SerializeInt(Ar, Item.ColumnSpan);
+			SerializeInt(Ar, Item.PayloadIndex);
+		}
+	}
+
+	/** Start times are delta-coded in microseconds, durations stored in nanoseconds. */
+	void SerializeEvent(FArchive& Ar, FOBGridTraceEvent& Event, uint64& InOutPreviousStartMicros)
+	{
+		uint8 OpAndOutcome = static_cast<uint8>(Event.Op) | (Event.bSucceeded ? 0x80 : 0);
+		Ar << OpAndOutcome;
+		Event.Op = static_cast<EOBGridTraceOp>(OpAndOutcome & 0x7F);
+		Event.bSucceeded = (OpAndOutcome & 0x80) != 0;
+		if (Event.Op >= EOBGridTraceOp::Num)
+		{
+			Ar.SetError();
+			return;
+		}
+
+		Ar.SerializeIntPacked(Event.GridKey);
+
+		const uint64 StartMicros = static_cast<uint64>(FMath::Max(0.0, Event.StartSeconds) * 1.0e6);
+		uint32 StartDeltaMicros = static_cast<uint32>(
+			FMath::Min<uint64>(StartMicros - FMath::Min(StartMicros, InOutPreviousStartMicros), MAX_uint32));
+		Ar.SerializeIntPacked(StartDeltaMicros);
+		InOutPreviousStartMicros += StartDeltaMicros;
+		Event.StartSeconds = InOutPreviousStartMicros * 1.0e-6;
+
+		uint32 DurationNanos = static_cast<uint32>(FMath::Min(Event.DurationSeconds * 1.0e9, double(MAX_uint32)));
+		Ar.SerializeIntPacked(DurationNanos);
+		Event.DurationSeconds = DurationNanos * 1.0e-9;
+
+		SerializeInt(Ar, Event.NumRows);
+		SerializeInt(Ar, Event.NumColumns);
+
+		const FOpLayout& Layout = OpLayouts[static_cast<int32>(Event.Op)];
+		for (int32 ArgIndex = 0; ArgIndex < Layout.NumArgs; ++ArgIndex)
+		{
+			SerializeInt(Ar, Event.Args[ArgIndex]);
+		}
+		if (Layout.bHasPayload)
+		{
+			SerializeInt(Ar, Event.PayloadIndex);
+		}
+		if (Layout.bHasResults)
+		{
+			int32 NumResults = Event.ResultItemIds.Num();
+			if (!SerializeNum(Ar, NumResults)) return;
+			Event.ResultItemIds.SetNum(NumResults);
+			for (int32& ItemId : Event.ResultItemIds)
+			{
+				SerializeInt(Ar, ItemId);
+			}
+		}
+		if (Layout.bHasLayout)
+		{
+			SerializeLayout(Ar, Event.Sections, Event.DisabledCells);
+		}
+	}
+
+	void SavePayload(const FInstancedStruct& Payload, TArray<uint8>& OutBytes)
+	{
+		FMemoryWriter MemoryWriter(OutBytes);
+		FObjectAndNameAsStringProxyArchive Ar(MemoryWriter, false);
+		// Saving leaves the payload untouched; Serialize is only non-const because it also loads.
+		const_cast<FInstancedStruct&>(Payload).Serialize(Ar);
+	}
+
+	double GetPercentile(const TArray<double>& SortedSamples, const double Percentile)
+	{
+		if (SortedSamples.IsEmpty()) return 0.0;
+		const int32 Index = FMath::CeilToInt(Percentile * SortedSamples.Num()) - 1;
+		return SortedSamples[FMath::Clamp(Index, 0, SortedSamples.Num() - 1)];
+	}
+
+	void StartFromCommandLine()
+	{
+		FString FilePath;
+		if (FParse::Value(FCommandLine::Get(), TEXT("-OBGridTrace="), FilePath) ||
+			FParse::Param(FCommandLine::Get(), TEXT("OBGridTrace")))
+		{
+			FOBGridTraceRecorder::Get().Start(FilePath);
+		}
+	}
+
+	bool ReplayFile(const FString& FilePath, const int32 Iterations, FOutputDevice& Ar,
+					TArray<FOBGridTraceOpStats>& OutStats)
+	{
+		FOBGridTrace Trace;
+		if (!Trace.LoadFromFile(FilePath))
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("Could not load grid trace '%s'."), *FilePath);
+			return false;
+		}
+
+		Ar.Logf(TEXT("Replaying '%s': %d operation(s) on %d grid(s), %d distinct payload(s), %d iteration(s)."),
+				*FilePath, Trace.Events.Num(), Trace.Grids.Num(), Trace.Payloads.Num(), FMath::Max(1, Iterations));
+		if (!FOBGridTraceReplayer::Replay(Trace, Iterations, OutStats))
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("Grid trace '%s' holds no operation."), *FilePath);
+			return false;
+		}
+		FOBGridTraceReplayer::PrintReport(OutStats, Ar);
+		return true;
+	}
+
+	static FAutoConsoleCommand GStartTraceCommand(
+		TEXT("OB.Grid.Trace.Start"),
+		TEXT("Records every UOBGridInventoryWidget operation to a trace file. Optional argument: the file path."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FOBGridTraceRecorder::Get().Start(Args.IsEmpty() ? FString() : Args[0]);
+		}));
+
+	static FAutoConsoleCommand GStopTraceCommand(
+		TEXT("OB.Grid.Trace.Stop"),
+		TEXT("Stops the grid trace started by OB.Grid.Trace.Start."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FOBGridTraceRecorder::Get().Stop();
+		}));
+
+	static FAutoConsoleCommandWithArgsAndOutputDevice GReplayTraceCommand(
+		TEXT("OB.Grid.Trace.Replay"),
+		TEXT("Replays a grid trace and prints per-operation latencies. Arguments: <file> [iterations]."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args,
+																		 FOutputDevice& Ar)
+		{
+			if (Args.IsEmpty())
+			{
+				Ar.Logf(TEXT("Usage: OB.Grid.Trace.Replay <file> [iterations]"));
+				return;
+			}
+			TArray<FOBGridTraceOpStats> Stats;
+			ReplayFile(Args[0], Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1, Ar, Stats);
+		}));
+}
+
+// --- Trace File ---
+
+bool FOBGridTrace::LoadFromFile(const FString& FilePath)
+{
+	Payloads.Reset();
+	Grids.Reset();
+	Events.Reset();
+
+	TArray<uint8> FileBytes;
+	if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath)) return false;
+
+	FMemoryReader Ar(FileBytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic << Version;
+	if (Ar.IsError() || Magic != OBGridTrace::FileMagic || Version != OBGridTrace::FileVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%hs] - '%s' is not a version %u grid trace."), __FUNCTION__, *FilePath,
+			   OBGridTrace::FileVersion);
+		return false;
+	}
+
+	uint64 PreviousStartMicros = 0;
+	while (!Ar.AtEnd() && !Ar.IsError())
+	{
+		uint8 RecordType = 0;
+		Ar << RecordType;
+		switch (static_cast<OBGridTrace::ERecordType>(RecordType))
+		{
+		case OBGridTrace::ERecordType::Payload:
+			Ar << Payloads.AddDefaulted_GetRef();
+			break;
+		case OBGridTrace::ERecordType::Grid:
+			OBGridTrace::SerializeGrid(Ar, Grids.AddDefaulted_GetRef());
+			break;
+		case OBGridTrace::ERecordType::Event:
+			OBGridTrace::SerializeEvent(Ar, Events.AddDefaulted_GetRef(), PreviousStartMicros);
+			if (Ar.IsError())
+			{
+				Events.Pop();
+			}
+			break;
+		default:
+			Ar.SetError();
+			break;
+		}
+	}
+
+	// A session that crashed leaves a truncated last record; everything before it is still usable.
+	if (Ar.IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%hs] - '%s' ends with a damaged record, keeping %d operation(s)."),
+			   __FUNCTION__, *FilePath, Events.Num());
+	}
+	return true;
+}
+
+bool FOBGridTrace::LoadPayload(const int32 PayloadIndex, FInstancedStruct& OutPayload) const
+{
+	OutPayload.Reset();
+	if (!Payloads.IsValidIndex(PayloadIndex)) return false;
+
+	FMemoryReader MemoryReader(Payloads[PayloadIndex]);
+	FObjectAndNameAsStringProxyArchive Ar(MemoryReader, true);
+	OutPayload.Serialize(Ar);
+	return !Ar.IsError();
+}
+
+// --- Recorder ---
+
+bool FOBGridTraceRecorder::bRecording = false;
+
+FOBGridTraceRecorder& FOBGridTraceRecorder::Get()
+{
+	static FOBGridTraceRecorder Recorder;
+	return Recorder;
+}
+
+bool FOBGridTraceRecorder::Start(const FString& InFilePath)
+{
+	check(IsInGameThread());
+	Stop();
+
+	FilePath = InFilePath.IsEmpty()
+		? FPaths::ProfilingDir() / TEXT("OBGridTraces") / FString::Printf(TEXT("Grid-%s.obgtrace"),
+																		  *FDateTime::Now().ToString())
+		: InFilePath;
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[%hs] - Could not open '%s' for writing."), __FUNCTION__, *FilePath);
+		FilePath.Reset();
+		return false;
+	}
+
+	uint32 Magic = OBGridTrace::FileMagic;
+	uint32 Version = OBGridTrace::FileVersion;
+	*Writer << Magic << Version;
+	StartCycles = FPlatformTime::Cycles64();
+	PreviousStartMicros = 0;
+	bRecording = true;
+	UE_LOG(LogTemp, Log, TEXT("[%hs] - Recording grid operations to '%s'."), __FUNCTION__, *FilePath);
+	return true;
+}
+
+void FOBGridTraceRecorder::Stop()
+{
+	if (!bRecording) return;
+
+	// Operations still running (Stop called from an event listener) are dropped.
+	bRecording = false;
+	++Session;
+	PendingEvents.Reset();
+	NumOpenScopes = 0;
+	GridKeys.Reset();
+	PayloadIndices.Reset();
+
+	const int64 FileSize = Writer->TotalSize();
+	Writer->Close();
+	Writer.Reset();
+	UE_LOG(LogTemp, Log, TEXT("[%hs] - Grid trace '%s' written (%.1f KB)."), __FUNCTION__, *FilePath,
+		   FileSize / 1024.0);
+}
+
+int32 FOBGridTraceRecorder::BeginEvent(const UOBGridItemState& State, uint32& OutGridKey)
+{
+	OutGridKey = FindOrAddGrid(State);
+	++NumOpenScopes;
+	return PendingEvents.AddDefaulted();
+}
+
+void FOBGridTraceRecorder::EndEvent(const uint32 InSession, const int32 Slot, FOBGridTraceEvent&& Event,
+									const FInstancedStruct* Payload)
+{
+	if (!bRecording || InSession != Session) return;
+
+	if (Payload)
+	{
+		Event.PayloadIndex = FindOrAddPayload(*Payload);
+	}
+	PendingEvents[Slot] = MoveTemp(Event);
+	if (--NumOpenScopes > 0) return;
+
+	for (TOptional<FOBGridTraceEvent>& PendingEvent : PendingEvents)
+	{
+		if (PendingEvent.IsSet())
+		{
+			WriteEvent(PendingEvent.GetValue());
+		}
+	}
+	PendingEvents.Reset();
+}
+
+uint32 FOBGridTraceRecorder::FindOrAddGrid(const UOBGridItemState& State)
+{
+	const TObjectKey<UOBGridItemState> StateKey(&State);
+	if (const uint32* GridKey = GridKeys.Find(StateKey)) return *GridKey;
+
+	FOBGridTraceGrid Grid;
+	Grid.GridKey = GridKeys.Num() + 1;
+	Grid.NumRows = State.GetNumRows();
+	Grid.NumColumns = State.GetNumColumns();
+	Grid.Sections = State.GetSections();
+	Grid.DisabledCells = State.GetDisabledCells();
+	for (const TPair<int32, FOBGridItemInfo>& Pair : State.GetItems())
+	{
+		const FOBGridItemInfo& Info = Pair.Value;
+		FOBGridTraceItem& Item = Grid.Items.AddDefaulted_GetRef();
+		Item.ItemId = Pair.Key;
+		Item.Row = Info.Row;
+		Item.Column = Info.Column;
+		Item.RowSpan = Info.RowSpan;
+		Item.ColumnSpan = Info.ColumnSpan;
+		Item.PayloadIndex = FindOrAddPayload(Info.CopyPayload());
+	}
+	Grid.Items.Sort([](const FOBGridTraceItem& A, const FOBGridTraceItem& B) { return A.ItemId < B.ItemId; });
+
+	GridKeys.Add(StateKey, Grid.GridKey);
+	uint8 RecordType = static_cast<uint8>(OBGridTrace::ERecordType::Grid);
+	*Writer << RecordType;
+	OBGridTrace::SerializeGrid(*Writer, Grid);
+	return Grid.GridKey;
+}
+
+int32 FOBGridTraceRecorder::FindOrAddPayload(const FInstancedStruct& Payload)
+{
+	TArray<uint8> PayloadBytes;
+	OBGridTrace::SavePayload(Payload, PayloadBytes);
+	const uint64 Hash = CityHash64(reinterpret_cast<const char*>(PayloadBytes.GetData()), PayloadBytes.Num());
+	if (const int32* PayloadIndex = PayloadIndices.Find(Hash)) return *PayloadIndex;
+
+	const int32 NewPayloadIndex = PayloadIndices.Num();
+	PayloadIndices.Add(Hash, NewPayloadIndex);
+	uint8 RecordType = static_cast<uint8>(OBGridTrace::ERecordType::Payload);
+	*Writer << RecordType << PayloadBytes;
+	return NewPayloadIndex;
+}
+
+void FOBGridTraceRecorder::WriteEvent(FOBGridTraceEvent& Event)
+{
+	uint8 RecordType = static_cast<uint8>(OBGridTrace::ERecordType::Event);
+	*Writer << RecordType;
+	OBGridTrace::SerializeEvent(*Writer, Event, PreviousStartMicros);
+}
+
+// --- Scope ---
+
+FOBGridTraceScope::FOBGridTraceScope(const UOBGridItemState* State, const EOBGridTraceOp Op, const int32 Arg0,
+									 const int32 Arg1, const int32 Arg2, const int32 Arg3)
+{
+	if (!FOBGridTraceRecorder::IsRecording() || !State) return;
+
+	FOBGridTraceRecorder& Recorder = FOBGridTraceRecorder::Get();
+	Slot = Recorder.BeginEvent(*State, Event.GridKey);
+	Session = Recorder.Session;
+	Event.Op = Op;
+	Event.Args[0] = Arg0;
+	Event.Args[1] = Arg1;
+	Event.Args[2] = Arg2;
+	Event.Args[3] = Arg3;
+	Event.NumRows = State->GetNumRows();
+	Event.NumColumns = State->GetNumColumns();
+
+	StartCycles = FPlatformTime::Cycles64();
+	Event.StartSeconds = FPlatformTime::ToSeconds64(StartCycles - Recorder.StartCycles);
+}
+
+FOBGridTraceScope::~FOBGridTraceScope()
+{
+	if (Slot == INDEX_NONE) return;
+	Event.DurationSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+	FOBGridTraceRecorder::Get().EndEvent(Session, Slot, MoveTemp(Event), Payload);
+}
+
+void FOBGridTraceScope::SetPayload(const FInstancedStruct& InPayload)
+{
+	if (Slot == INDEX_NONE) return;
+	Payload = &InPayload;
+}
+
+void FOBGridTraceScope::SetLayout(const TArray<FOBGridSection>& Sections, const TArray<FIntPoint>& DisabledCells)
+{
+	if (Slot == INDEX_NONE) return;
+	Event.Sections = Sections;
+	Event.DisabledCells = DisabledCells;
+}
+
+void FOBGridTraceScope::SetSucceeded(const bool bSucceeded)
+{
+	if (Slot == INDEX_NONE) return;
+	Event.bSucceeded = bSucceeded;
+}
+
+void FOBGridTraceScope::SetResult(const int32 ItemId)
+{
+	if (Slot == INDEX_NONE) return;
+	Event.bSucceeded = ItemId != INDEX_NONE;
+	if (Event.bSucceeded)
+	{
+		Event.ResultItemIds.Add(ItemId);
+	}
+}
+
+void FOBGridTraceScope::SetResult(const bool bSucceeded, const TArray<int32>& ItemIds)
+{
+	if (Slot == INDEX_NONE) return;
+	Event.bSucceeded = bSucceeded;
+	Event.ResultItemIds = ItemIds;
+}
+
+// --- Replay ---
+
+bool FOBGridTraceReplayer::Replay(const FOBGridTrace& Trace, const int32 Iterations,
+								  TArray<FOBGridTraceOpStats>& OutStats)
+{
+	OutStats.Reset();
+	if (Trace.Events.IsEmpty()) return false;
+
+	// Payloads are rebuilt up front so the timings do not include deserialization.
+	TArray<FInstancedStruct> Payloads;
+	Payloads.SetNum(Trace.Payloads.Num());
+	for (int32 PayloadIndex = 0; PayloadIndex < Payloads.Num(); ++PayloadIndex)
+	{
+		Trace.LoadPayload(PayloadIndex, Payloads[PayloadIndex]);
+	}
+	const FInstancedStruct EmptyPayload;
+	auto GetPayload = [&Payloads, &EmptyPayload](const int32 PayloadIndex) -> const FInstancedStruct&
+	{
+		return Payloads.IsValidIndex(PayloadIndex) ? Payloads[PayloadIndex] : EmptyPayload;
+	};
+
+	constexpr int32 NumOps = static_cast<int32>(EOBGridTraceOp::Num);
+	TArray<double> ReplayedMicros[NumOps];
+	TArray<double> RecordedMicros[NumOps];
+	int32 NumMismatches[NumOps] = {};
+	for (const FOBGridTraceEvent& Event : Trace.Events)
+	{
+		RecordedMicros[static_cast<int32>(Event.Op)].Add(Event.DurationSeconds * 1.0e6);
+	}
+
+	for (int32 Iteration = 0; Iteration < FMath::Max(1, Iterations); ++Iteration)
+	{
+		TMap<uint32, TStrongObjectPtr<UOBGridItemState>> States;
+
+		// Recorded ItemId -> replayed ItemId, and the same for reservation ids, per grid.
+		TMap<uint32, TMap<int32, int32>> ItemIdMaps;
+		TMap<uint32, TMap<int32, int32>> ReservationIdMaps;
+		for (const FOBGridTraceGrid& Grid : Trace.Grids)
+		{
+			UOBGridItemState* State = NewObject<UOBGridItemState>(GetTransientPackage());
+			States.Add(Grid.GridKey, TStrongObjectPtr<UOBGridItemState>(State));
+			State->Initialize(Grid.NumRows, Grid.NumColumns, Grid.Sections, Grid.DisabledCells);
+
+			TMap<int32, int32>& ItemIdMap = ItemIdMaps.Add(Grid.GridKey);
+			for (const FOBGridTraceItem& Item : Grid.Items)
+			{
+				ItemIdMap.Add(Item.ItemId, State->AddItemAt(GetPayload(Item.PayloadIndex), Item.RowSpan,
+															Item.ColumnSpan, Item.Row, Item.Column));
+			}
+		}
+
+		for (const FOBGridTraceEvent& Event : Trace.Events)
+		{
+			const int32 OpIndex = static_cast<int32>(Event.Op);
+			const TStrongObjectPtr<UOBGridItemState>* StatePtr = States.Find(Event.GridKey);
+			if (!StatePtr)
+			{
+				NumMismatches[OpIndex] += Iteration == 0 ? 1 : 0;
+				continue;
+			}
+
+			UOBGridItemState& State = **StatePtr;
+			TMap<int32, int32>& ItemIdMap = ItemIdMaps.FindChecked(Event.GridKey);
+			TMap<int32, int32>& ReservationIdMap = ReservationIdMaps.FindOrAdd(Event.GridKey);
+			const int32* MappedReservationIdPtr = ReservationIdMap.Find(Event.Args[0]);
+			const int32 MappedReservationId = MappedReservationIdPtr ? *MappedReservationIdPtr : INDEX_NONE;
+			const int32* MappedItemIdPtr = ItemIdMap.Find(Event.Args[0]);
+			const int32 MappedItemId = MappedItemIdPtr ? *MappedItemIdPtr : INDEX_NONE;
+			const FInstancedStruct& Payload = GetPayload(Event.PayloadIndex);
+			const int32* Args = Event.Args;
+
+			TArray<int32> PlacedItemIds;
+			TArray<FOBGridItemInfo> OverflowedItems;
+			FOBGridStackAddResult StackResult;
+			int32 ReservationId = INDEX_NONE;
+			bool bSucceeded = true;
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			switch (Event.Op)
+			{
+			case EOBGridTraceOp::InitializeGrid:
+				State.Initialize(Args[0], Args[1], Event.Sections, Event.DisabledCells);
+				break;
+			case EOBGridTraceOp::ResizeGrid:
+				bSucceeded = State.Resize(Args[0], Args[1], static_cast<EOBGridResizePolicy>(Args[2]),
+										  OverflowedItems);
+				break;
+			case EOBGridTraceOp::SetGridLayout:
+				bSucceeded = State.SetLayout(Event.Sections, Event.DisabledCells);
+				break;
+			case EOBGridTraceOp::AddItem:
+				PlacedItemIds.Add(State.AddItem(Payload, Args[0], Args[1], nullptr, Args[2]));
+				break;
+			case EOBGridTraceOp::AddItemAt:
+				PlacedItemIds.Add(State.AddItemAt(Payload, Args[0], Args[1], Args[2], Args[3]));
+				break;
+			case EOBGridTraceOp::AddStackableItem:
+				bSucceeded = State.AddStackableItem(Payload, Args[0], Args[1], nullptr, Args[2] != 0, StackResult);
+				break;
+			case EOBGridTraceOp::RemoveItem:
+				bSucceeded = State.RemoveItem(MappedItemId);
+				break;
+			case EOBGridTraceOp::MoveItem:
+				bSucceeded = State.MoveItem(MappedItemId, Args[1], Args[2]);
+				break;
+			case EOBGridTraceOp::SetItemPayload:
+				bSucceeded = State.SetItemPayload(MappedItemId, Payload);
+				break;
+			case EOBGridTraceOp::ClearGrid:
+				State.ClearItems();
+				break;
+			case EOBGridTraceOp::ReserveMove:
+				ReservationId = State.ReserveMove(MappedItemId, Args[1], Args[2]);
+				bSucceeded = ReservationId != INDEX_NONE;
+				break;
+			case EOBGridTraceOp::ConfirmReservation:
+				bSucceeded = State.ConfirmReservation(MappedReservationId);
+				break;
+			case EOBGridTraceOp::RollbackReservation:
+				bSucceeded = State.RollbackReservation(MappedReservationId);
+				break;
+			default:
+				break;
+			}
+			ReplayedMicros[OpIndex].Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e6);
+
+			if (Event.Op == EOBGridTraceOp::AddStackableItem)
+			{
+				PlacedItemIds = MoveTemp(StackResult.PlacedItemIds);
+			}
+			else if (!PlacedItemIds.IsEmpty())
+			{
+				bSucceeded = PlacedItemIds[0] != INDEX_NONE;
+			}
+			for (int32 Index = 0; Index < FMath::Min(PlacedItemIds.Num(), Event.ResultItemIds.Num()); ++Index)
+			{
+				ItemIdMap.Add(Event.ResultItemIds[Index], PlacedItemIds[Index]);
+			}
+			if (Event.Op == EOBGridTraceOp::ReserveMove && !Event.ResultItemIds.IsEmpty())
+			{
+				ReservationIdMap.Add(Event.ResultItemIds[0], ReservationId);
+			}
+			if (Iteration == 0 && bSucceeded != Event.bSucceeded)
+			{
+				++NumMismatches[OpIndex];
+			}
+		}
+	}
+
+	for (int32 OpIndex = 0; OpIndex < NumOps; ++OpIndex)
+	{
+		TArray<double>& Samples = ReplayedMicros[OpIndex];
+		if (Samples.IsEmpty()) continue;
+		Samples.Sort();
+		RecordedMicros[OpIndex].Sort();
+
+		double TotalMicros = 0.0;
+		for (const double Sample : Samples)
+		{
+			TotalMicros += Sample;
+		}
+
+		FOBGridTraceOpStats& Stats = OutStats.AddDefaulted_GetRef();
+		Stats.Op = static_cast<EOBGridTraceOp>(OpIndex);
+		Stats.Count = Samples.Num();
+		Stats.NumMismatches = NumMismatches[OpIndex];
+		Stats.MeanMicros = TotalMicros / Samples.Num();
+		Stats.P50Micros = OBGridTrace::GetPercentile(Samples, 0.50);
+		Stats.P90Micros = OBGridTrace::GetPercentile(Samples, 0.90);
+		Stats.P99Micros = OBGridTrace::GetPercentile(Samples, 0.99);
+		Stats.MaxMicros = Samples.Last();
+		Stats.RecordedP50Micros = OBGridTrace::GetPercentile(RecordedMicros[OpIndex], 0.50);
+		Stats.RecordedP99Micros = OBGridTrace::GetPercentile(RecordedMicros[OpIndex], 0.99);
+	}
+	return true;
+}
+
+void FOBGridTraceReplayer::PrintReport(const TArray<FOBGridTraceOpStats>& Stats, FOutputDevice& Ar)
+{
+	Ar.Logf(TEXT("OBGridInventory trace replay (microseconds; 'Rec' columns were measured live, view included):"));
+	Ar.Logf(TEXT("%-18s %8s %8s %10s %10s %10s %10s %10s %10s %10s"), TEXT("Operation"), TEXT("Count"),
+			TEXT("Diverged"), TEXT("Mean"), TEXT("P50"), TEXT("P90"), TEXT("P99"), TEXT("Max"), TEXT("RecP50"),
+			TEXT("RecP99"));
+	for (const FOBGridTraceOpStats& OpStats : Stats)
+	{
+		Ar.Logf(TEXT("%-18s %8d %8d %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f"),
+				*StaticEnum<EOBGridTraceOp>()->GetNameStringByValue(static_cast<int64>(OpStats.Op)), OpStats.Count,
+				OpStats.NumMismatches, OpStats.MeanMicros, OpStats.P50Micros, OpStats.P90Micros, OpStats.P99Micros,
+				OpStats.MaxMicros, OpStats.RecordedP50Micros, OpStats.RecordedP99Micros);
+	}
+}
+
+FString FOBGridTraceReplayer::ToCsv(const TArray<FOBGridTraceOpStats>& Stats)
+{
+	FString Csv = TEXT("Operation,Count,Diverged,MeanUs,P50Us,P90Us,P99Us,MaxUs,RecordedP50Us,RecordedP99Us\n");
+	for (const FOBGridTraceOpStats& OpStats : Stats)
+	{
+		Csv += FString::Printf(TEXT("%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+							   *StaticEnum<EOBGridTraceOp>()->GetNameStringByValue(static_cast<int64>(OpStats.Op)),
+							   OpStats.Count, OpStats.NumMismatches, OpStats.MeanMicros, OpStats.P50Micros,
+							   OpStats.P90Micros, OpStats.P99Micros, OpStats.MaxMicros, OpStats.RecordedP50Micros,
+							   OpStats.RecordedP99Micros);
+	}
+	return Csv;
+}
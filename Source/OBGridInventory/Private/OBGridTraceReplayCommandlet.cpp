@@ -0,0 +1,43 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "OBGridTraceReplayCommandlet.h"
+
+#include "OBGridTrace.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+
+UOBGridTraceReplayCommandlet::UOBGridTraceReplayCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UOBGridTraceReplayCommandlet::Main(const FString& Params)
+{
+	FString TracePath;
+	if (!FParse::Value(*Params, TEXT("Trace="), TracePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[%s::%hs] - Usage: -run=OBGridTraceReplay -Trace=<File> [-Iterations=N] "
+			"[-Csv=<File>]"), *GetNameSafe(this), __FUNCTION__);
+		return 1;
+	}
+
+	int32 Iterations = 1;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+
+	TArray<FOBGridTraceOpStats> Stats;
+	if (!OBGridTrace::ReplayFile(TracePath, Iterations, *GLog, Stats)) return 1;
+
+	if (FString CsvPath; FParse::Value(*Params, TEXT("Csv="), CsvPath))
+	{
+		if (!FFileHelper::SaveStringToFile(FOBGridTraceReplayer::ToCsv(Stats), *CsvPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s::%hs] - Could not write '%s'."), *GetNameSafe(this), __FUNCTION__,
+				   *CsvPath);
+			return 1;
+		}
+	}
+	return 0;
+}
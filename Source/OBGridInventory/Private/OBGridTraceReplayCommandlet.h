@@ -0,0 +1,23 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OBGridTraceReplayCommandlet.generated.h"
+
+/**
+ * Headless replay of a grid trace recorded with OB.Grid.Trace.Start:
+ *   UnrealEditor-Cmd <Project> -run=OBGridTraceReplay -Trace=<File> [-Iterations=N] [-Csv=<File>]
+ * Prints per-operation latency percentiles; the CSV makes runs of two plugin versions easy to diff.
+ */
+UCLASS()
+class UOBGridTraceReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UOBGridTraceReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,210 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "SOBGridPanel.h"
+
+#include "OBGridPainting.h"
+#include "Layout/ArrangedChildren.h"
+
+// --- Slot ---
+
+void SOBGridPanel::FSlot::Construct(const FChildren& SlotOwner, FSlotArguments&& InArgs)
+{
+	TSlotBase<FSlot>::Construct(SlotOwner, MoveTemp(InArgs));
+	Row = FMath::Max(InArgs._Row.Get(Row), 0);
+	Column = FMath::Max(InArgs._Column.Get(Column), 0);
+	RowSpan = FMath::Max(InArgs._RowSpan.Get(RowSpan), 1);
+	ColumnSpan = FMath::Max(InArgs._ColumnSpan.Get(ColumnSpan), 1);
+}
+
+void SOBGridPanel::FSlot::SetCell(const int32 InRow, const int32 InColumn)
+{
+	if (Row == InRow && Column == InColumn) return;
+	Row = FMath::Max(InRow, 0);
+	Column = FMath::Max(InColumn, 0);
+	InvalidateOwnerLayout();
+}
+
+void SOBGridPanel::FSlot::SetSpan(const int32 InRowSpan, const int32 InColumnSpan)
+{
+	if (RowSpan == InRowSpan && ColumnSpan == InColumnSpan) return;
+	RowSpan = FMath::Max(InRowSpan, 1);
+	ColumnSpan = FMath::Max(InColumnSpan, 1);
+	InvalidateOwnerLayout();
+}
+
+void SOBGridPanel::FSlot::InvalidateOwnerLayout() const
+{
+	if (SWidget* OwnerWidget = GetOwnerWidget())
+	{
+		OwnerWidget->Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+// --- Panel ---
+
+SOBGridPanel::SOBGridPanel()
+	: Children(this)
+{
+	SetCanTick(false);
+	bCanSupportFocus = false;
+}
+
+SOBGridPanel::FSlot::FSlotArguments SOBGridPanel::Slot()
+{
+	return FSlot::FSlotArguments(MakeUnique<FSlot>());
+}
+
+void SOBGridPanel::Construct(const FArguments& InArgs)
+{
+	NumRows = FMath::Max(InArgs._NumRows, 1);
+	NumColumns = FMath::Max(InArgs._NumColumns, 1);
+	CellSize = FMath::Max(InArgs._CellSize, 1.0f);
+	Children.AddSlots(MoveTemp(const_cast<TArray<FSlot::FSlotArguments>&>(InArgs._Slots)));
+}
+
+SOBGridPanel::FScopedWidgetSlotArguments SOBGridPanel::AddSlot(const int32 Row, const int32 Column,
+															   const int32 RowSpan, const int32 ColumnSpan)
+{
+	FScopedWidgetSlotArguments SlotArguments{MakeUnique<FSlot>(), Children, INDEX_NONE};
+	SlotArguments.Row(Row).Column(Column).RowSpan(RowSpan).ColumnSpan(ColumnSpan);
+	return MoveTemp(SlotArguments);
+}
+
+int32 SOBGridPanel::RemoveSlot(const TSharedRef<SWidget>& SlotWidget)
+{
+	return Children.Remove(SlotWidget);
+}
+
+void SOBGridPanel::ClearChildren()
+{
+	Children.Empty();
+}
+
+void SOBGridPanel::SetGridSize(const int32 InNumRows, const int32 InNumColumns)
+{
+	const int32 NewRows = FMath::Max(InNumRows, 1);
+	const int32 NewColumns = FMath::Max(InNumColumns, 1);
+	if (NewRows == NumRows && NewColumns == NumColumns) return;
+	NumRows = NewRows;
+	NumColumns = NewColumns;
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+void SOBGridPanel::SetCellSize(const float InCellSize)
+{
+	if (FMath::IsNearlyEqual(CellSize, InCellSize)) return;
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+void SOBGridPanel::SetGridScale(const float InGridScale)
+{
+	if (FMath::IsNearlyEqual(GridScale, InGridScale)) return;
+	GridScale = FMath::Max(InGridScale, KINDA_SMALL_NUMBER);
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+void SOBGridPanel::SetGridLines(const bool bInDrawGridLines, const FLinearColor& InGridLineColor,
+								const float InGridLineThickness, const FLinearColor& InBorderLineColor,
+								const float InBorderLineThickness)
+{
+	bDrawGridLines = bInDrawGridLines;
+	GridLineColor = InGridLineColor;
+	GridLineThickness = FMath::Max(InGridLineThickness, 0.0f);
+	BorderLineColor = InBorderLineColor;
+	BorderLineThickness = FMath::Max(InBorderLineThickness, 0.0f);
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SOBGridPanel::SetCellSections(TArray<int32> InCellSections)
+{
+	CellSections = MoveTemp(InCellSections);
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SOBGridPanel::SetPaintedItemStyle(const FOBGridPaintedItemStyle& InStyle)
+{
+	PaintedItemStyle = InStyle;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SOBGridPanel::SetPaintedItem(const int32 ItemId, const FOBGridPaintedItem& Item)
+{
+	PaintedItems.Add(ItemId, Item);
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SOBGridPanel::RemovePaintedItem(const int32 ItemId)
+{
+	if (PaintedItems.Remove(ItemId) > 0)
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+void SOBGridPanel::ClearPaintedItems()
+{
+	if (PaintedItems.IsEmpty()) return;
+	PaintedItems.Empty();
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SOBGridPanel::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const
+{
+	const float ScaledCellSize = GetScaledCellSize();
+	for (int32 ChildIndex = 0; ChildIndex < Children.Num(); ++ChildIndex)
+	{
+		const FSlot& CurSlot = Children[ChildIndex];
+		const TSharedRef<SWidget>& ChildWidget = CurSlot.GetWidget();
+		if (!ArrangedChildren.Accepts(ChildWidget->GetVisibility())) continue;
+
+		const FVector2D Offset(CurSlot.GetColumn() * ScaledCellSize, CurSlot.GetRow() * ScaledCellSize);
+		const FVector2D Size(CurSlot.GetColumnSpan() * ScaledCellSize, CurSlot.GetRowSpan() * ScaledCellSize);
+		ArrangedChildren.AddWidget(AllottedGeometry.MakeChild(ChildWidget, Size, FSlateLayoutTransform(Offset)));
+	}
+}
+
+int32 SOBGridPanel::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+							const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements,
+							const int32 LayerId, const FWidgetStyle& InWidgetStyle, const bool bParentEnabled) const
+{
+	int32 MaxLayerId = LayerId;
+	if (bDrawGridLines)
+	{
+		OBGridPainting::FGridLineParams LineParams;
+		LineParams.NumRows = NumRows;
+		LineParams.NumColumns = NumColumns;
+		LineParams.ScaledCellSize = GetScaledCellSize();
+		LineParams.GridLineThickness = FMath::Max(1.0f, GridLineThickness * GridScale);
+		LineParams.BorderLineThickness = FMath::Max(1.0f, BorderLineThickness * GridScale);
+		LineParams.GridLineColor = GridLineColor;
+		LineParams.BorderLineColor = BorderLineColor;
+		LineParams.CellSections = CellSections;
+		OBGridPainting::PaintGridLines(LineParams, AllottedGeometry, OutDrawElements, LayerId);
+		++MaxLayerId;
+	}
+
+	if (!PaintedItems.IsEmpty())
+	{
+		// One pass for every painted item; only the few materialized item widgets are real children.
+		OBGridPainting::PaintItems(PaintedItems, PaintedItemStyle, GetScaledCellSize(), GridScale, AllottedGeometry,
+								   MyCullingRect, OutDrawElements, MaxLayerId);
+		MaxLayerId += 2;
+	}
+
+	FArrangedChildren ArrangedChildren(EVisibility::Visible);
+	ArrangeChildren(AllottedGeometry, ArrangedChildren);
+	return PaintArrangedChildren(Args, ArrangedChildren, AllottedGeometry, MyCullingRect, OutDrawElements,
+								 MaxLayerId, InWidgetStyle, ShouldBeEnabled(bParentEnabled));
+}
+
+FChildren* SOBGridPanel::GetChildren()
+{
+	return &Children;
+}
+
+FVector2D SOBGridPanel::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	const float ScaledCellSize = GetScaledCellSize();
+	return FVector2D(NumColumns * ScaledCellSize, NumRows * ScaledCellSize);
+}
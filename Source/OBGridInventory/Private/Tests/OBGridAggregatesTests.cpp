@@ -0,0 +1,60 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+#include "OBGridAggregates.h"
+#include "OBGridItemTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBGridAggregateMinMaxTest, "OBGridInventory.Aggregates.MinMaxRescan",
+								 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOBGridAggregateMinMaxTest::RunTest(const FString& Parameters)
+{
+	FOBGridAggregateSet Aggregates;
+	for (const EOBGridAggregateOp Op : {EOBGridAggregateOp::Min, EOBGridAggregateOp::Max})
+	{
+		FOBGridAggregateSpec Spec;
+		Spec.AggregateName = Op == EOBGridAggregateOp::Min ? TEXT("MinQuantity") : TEXT("MaxQuantity");
+		Spec.PayloadStruct = FOBGridStackablePayload::StaticStruct();
+		Spec.PropertyName = GET_MEMBER_NAME_CHECKED(FOBGridStackablePayload, Quantity);
+		Spec.Op = Op;
+		Aggregates.Register(Spec);
+	}
+
+	TArray<FOBGridStackablePayload> Payloads;
+	for (const int32 Quantity : {3, 7, 7, 5, 1})
+	{
+		FOBGridStackablePayload& Payload = Payloads.AddDefaulted_GetRef();
+		Payload.Quantity = Quantity;
+		Aggregates.AddPayload(FConstStructView::Make(Payload));
+	}
+
+	double Value = 0.0;
+	TestTrue(TEXT("Max known"), Aggregates.GetValue(TEXT("MaxQuantity"), Value));
+	TestEqual(TEXT("Max"), Value, 7.0);
+	TestTrue(TEXT("Min known"), Aggregates.GetValue(TEXT("MinQuantity"), Value));
+	TestEqual(TEXT("Min"), Value, 1.0);
+
+	// One of two payloads holding the extreme leaves: nothing to rescan.
+	Aggregates.RemovePayload(FConstStructView::Make(Payloads[1]));
+	Aggregates.GetValue(TEXT("MaxQuantity"), Value);
+	TestEqual(TEXT("Max with a duplicate left"), Value, 7.0);
+
+	// The last one leaves: the next distinct value takes over.
+	Aggregates.RemovePayload(FConstStructView::Make(Payloads[2]));
+	Aggregates.GetValue(TEXT("MaxQuantity"), Value);
+	TestEqual(TEXT("Max after rescan"), Value, 5.0);
+
+	Aggregates.RemovePayload(FConstStructView::Make(Payloads[4]));
+	Aggregates.GetValue(TEXT("MinQuantity"), Value);
+	TestEqual(TEXT("Min after rescan"), Value, 3.0);
+
+	Aggregates.RemovePayload(FConstStructView::Make(Payloads[0]));
+	Aggregates.RemovePayload(FConstStructView::Make(Payloads[3]));
+	TestFalse(TEXT("Max without payloads"), Aggregates.GetValue(TEXT("MaxQuantity"), Value));
+	TestFalse(TEXT("Min without payloads"), Aggregates.GetValue(TEXT("MinQuantity"), Value));
+	return true;
+}
+
+#endif
@@ -0,0 +1,120 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+#include "OBGridItemState.h"
+#include "OBGridItemTypes.h"
+#include "StructUtils/InstancedStruct.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace OBGridItemStateTests
+{
+	UOBGridItemState* MakeState(const int32 NumRows, const int32 NumColumns)
+	{
+		UOBGridItemState* State = NewObject<UOBGridItemState>(GetTransientPackage());
+		State->Initialize(NumRows, NumColumns, TArray<FOBGridSection>(), TArray<FIntPoint>());
+		return State;
+	}
+
+	int32 AddItem(UOBGridItemState& State, const int32 Row, const int32 Column)
+	{
+		return State.AddItemAt(FInstancedStruct::Make(FOBGridStackablePayload()), 1, 1, Row, Column);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBGridReservationRollbackTest, "OBGridInventory.State.Reservations.Rollback",
+								 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOBGridReservationRollbackTest::RunTest(const FString& Parameters)
+{
+	UOBGridItemState* State = OBGridItemStateTests::MakeState(4, 4);
+	const int32 ItemId = OBGridItemStateTests::AddItem(*State, 0, 0);
+
+	const int32 ReservationId = State->ReserveMove(ItemId, 0, 2);
+	TestNotEqual(TEXT("Reserved"), ReservationId, static_cast<int32>(INDEX_NONE));
+	TestTrue(TEXT("Pending"), State->IsItemPending(ItemId));
+	TestEqual(TEXT("Held cell"), State->GetOccupancy().GetCell(0, 0), FOBGridOccupancy::ReservedCell);
+	TestEqual(TEXT("Predicted cell"), State->GetOccupancy().GetCell(0, 2), ItemId);
+	TestEqual(TEXT("Held cells count as occupied"), State->GetNumOccupiedCells(), 2);
+
+	TestTrue(TEXT("Rolled back"), State->RollbackReservation(ReservationId));
+	TestFalse(TEXT("No longer pending"), State->IsItemPending(ItemId));
+	TestEqual(TEXT("Item back"), State->GetOccupancy().GetCell(0, 0), ItemId);
+	TestEqual(TEXT("Predicted cell freed"), State->GetOccupancy().GetCell(0, 2), FOBGridOccupancy::FreeCell);
+	TestEqual(TEXT("Occupied cells"), State->GetNumOccupiedCells(), 1);
+	TestFalse(TEXT("Second rollback refused"), State->RollbackReservation(ReservationId));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBGridReservationConfirmTest, "OBGridInventory.State.Reservations.Confirm",
+								 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOBGridReservationConfirmTest::RunTest(const FString& Parameters)
+{
+	UOBGridItemState* State = OBGridItemStateTests::MakeState(4, 4);
+	const int32 ItemId = OBGridItemStateTests::AddItem(*State, 0, 0);
+
+	const int32 ReservationId = State->ReserveMove(ItemId, 0, 2);
+	TestTrue(TEXT("Confirmed"), State->ConfirmReservation(ReservationId));
+	TestFalse(TEXT("No longer pending"), State->IsItemPending(ItemId));
+	TestEqual(TEXT("Held cell freed"), State->GetOccupancy().GetCell(0, 0), FOBGridOccupancy::FreeCell);
+	TestEqual(TEXT("Item stays"), State->GetOccupancy().GetCell(0, 2), ItemId);
+	TestEqual(TEXT("Occupied cells"), State->GetNumOccupiedCells(), 1);
+	TestFalse(TEXT("Rollback after confirm refused"), State->RollbackReservation(ReservationId));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBGridReservationResizeTest, "OBGridInventory.State.Reservations.RejectedResize",
+								 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOBGridReservationResizeTest::RunTest(const FString& Parameters)
+{
+	UOBGridItemState* State = OBGridItemStateTests::MakeState(4, 4);
+	const int32 ItemId = OBGridItemStateTests::AddItem(*State, 0, 0);
+	const int32 ReservationId = State->ReserveMove(ItemId, 3, 3);
+
+	// Repack could fit the item, but it is pending: the resize waits for the authority instead.
+	TArray<FOBGridItemInfo> OverflowedItems;
+	TestFalse(TEXT("Resize refused"), State->Resize(2, 2, EOBGridResizePolicy::Repack, OverflowedItems));
+	TestEqual(TEXT("Rows kept"), State->GetNumRows(), 4);
+	TestTrue(TEXT("Still pending"), State->IsItemPending(ItemId));
+	TestEqual(TEXT("Held cell"), State->GetOccupancy().GetCell(0, 0), FOBGridOccupancy::ReservedCell);
+	TestEqual(TEXT("Predicted cell"), State->GetOccupancy().GetCell(3, 3), ItemId);
+	TestEqual(TEXT("Occupied cells"), State->GetNumOccupiedCells(), 2);
+
+	// A resize that keeps both the item and its held cells goes through and keeps the reservation.
+	TestTrue(TEXT("Resize kept"), State->Resize(4, 5, EOBGridResizePolicy::Reject, OverflowedItems));
+	TestTrue(TEXT("Still pending after resize"), State->IsItemPending(ItemId));
+	TestTrue(TEXT("Rolled back"), State->RollbackReservation(ReservationId));
+	TestEqual(TEXT("Item back"), State->GetOccupancy().GetCell(0, 0), ItemId);
+	TestEqual(TEXT("Occupied cells after rollback"), State->GetNumOccupiedCells(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBGridReservationMoveTest, "OBGridInventory.State.Reservations.FailedMove",
+								 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOBGridReservationMoveTest::RunTest(const FString& Parameters)
+{
+	UOBGridItemState* State = OBGridItemStateTests::MakeState(4, 4);
+	const int32 ItemId = OBGridItemStateTests::AddItem(*State, 0, 0);
+	const int32 OtherItemId = OBGridItemStateTests::AddItem(*State, 1, 1);
+	const int32 ReservationId = State->ReserveMove(ItemId, 0, 1);
+
+	TestFalse(TEXT("Move onto another item refused"), State->MoveItem(ItemId, 1, 1));
+	TestTrue(TEXT("Still pending"), State->IsItemPending(ItemId));
+	TestEqual(TEXT("Held cell"), State->GetOccupancy().GetCell(0, 0), FOBGridOccupancy::ReservedCell);
+	TestEqual(TEXT("Other item untouched"), State->GetOccupancy().GetCell(1, 1), OtherItemId);
+	TestEqual(TEXT("Occupied cells"), State->GetNumOccupiedCells(), 3);
+
+	// The item's own held cells count as free for an authoritative move.
+	TestTrue(TEXT("Move onto the held cell"), State->MoveItem(ItemId, 0, 0));
+	TestFalse(TEXT("No longer pending"), State->IsItemPending(ItemId));
+	TestEqual(TEXT("Item moved"), State->GetOccupancy().GetCell(0, 0), ItemId);
+	TestEqual(TEXT("Predicted cell freed"), State->GetOccupancy().GetCell(0, 1), FOBGridOccupancy::FreeCell);
+	TestEqual(TEXT("Occupied cells after move"), State->GetNumOccupiedCells(), 2);
+	TestFalse(TEXT("Dropped reservation cannot roll back"), State->RollbackReservation(ReservationId));
+	return true;
+}
+
+#endif
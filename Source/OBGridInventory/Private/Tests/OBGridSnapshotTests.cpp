@@ -0,0 +1,67 @@
+// Copyright (c) 2024. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+#include "OBGridItemState.h"
+#include "OBGridItemTypes.h"
+#include "OBGridSnapshot.h"
+#include "Containers/Ticker.h"
+#include "StructUtils/InstancedStruct.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBGridSnapshotChannelTest, "OBGridInventory.Snapshots.Channel",
+								 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOBGridSnapshotChannelTest::RunTest(const FString& Parameters)
+{
+	FOBGridSnapshotChannel Channel;
+	TestFalse(TEXT("Empty before the first publication"), Channel.Acquire().IsValid());
+
+	// More publications than slots, holding every snapshot: a held copy never blocks a slot.
+	TArray<FOBGridSnapshotPtr> Published;
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		FOBGridSnapshotPtr Snapshot = MakeShared<FOBGridSnapshot, ESPMode::ThreadSafe>();
+		TestTrue(TEXT("Published"), Channel.Publish(Snapshot));
+		TestTrue(TEXT("Latest acquired"), Channel.Acquire() == Snapshot);
+		Published.Add(MoveTemp(Snapshot));
+	}
+	TestEqual(TEXT("Reused slot released its copy"), Published[0].GetSharedReferenceCount(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBGridSnapshotStateTest, "OBGridInventory.Snapshots.State",
+								 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOBGridSnapshotStateTest::RunTest(const FString& Parameters)
+{
+	UOBGridItemState* State = NewObject<UOBGridItemState>(GetTransientPackage());
+	State->Initialize(2, 2, TArray<FOBGridSection>(), TArray<FIntPoint>());
+	State->SetPublishSnapshots(true);
+
+	const FOBGridSnapshotPtr Before = State->GetSnapshot();
+	if (!TestTrue(TEXT("Published on enable"), Before.IsValid())) return false;
+
+	// Changes are published once per frame: the snapshot lags until the next core tick.
+	const int32 ItemId = State->AddItemAt(FInstancedStruct::Make(FOBGridStackablePayload()), 1, 1, 1, 1);
+	State->AddItemAt(FInstancedStruct::Make(FOBGridStackablePayload()), 1, 1, 0, 0);
+	TestTrue(TEXT("Not published before the tick"), State->GetSnapshot() == Before);
+
+	FTSTicker::GetCoreTicker().Tick(0.0f);
+	const FOBGridSnapshotPtr After = State->GetSnapshot();
+	if (!TestTrue(TEXT("Published on tick"), After.IsValid())) return false;
+	TestTrue(TEXT("Newer version"), After->GetVersion() > Before->GetVersion());
+	TestEqual(TEXT("One snapshot covers both changes"), After->GetVersion(),
+			  State->GetChangeJournal().GetLatestSequence());
+	TestEqual(TEXT("Item in the new snapshot"), After->GetItemIdAtCell(1, 1), ItemId);
+	TestEqual(TEXT("Held snapshot unchanged"), Before->GetItemIdAtCell(1, 1), static_cast<int32>(INDEX_NONE));
+
+	// Readers keep the channel, which outlives the state that feeds it.
+	const TSharedRef<const FOBGridSnapshotChannel, ESPMode::ThreadSafe> Channel = State->GetSnapshotChannel();
+	State->SetPublishSnapshots(false);
+	TestFalse(TEXT("Disabling publishes a null snapshot"), Channel->Acquire().IsValid());
+	TestEqual(TEXT("Held snapshot still readable"), After->GetItemIdAtCell(1, 1), ItemId);
+	return true;
+}
+
+#endif
@@ -0,0 +1,128 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StructUtils/StructView.h"
+#include "UObject/ObjectKey.h"
+#include "OBGridAggregates.generated.h"
+
+UENUM(BlueprintType)
+enum class EOBGridAggregateOp : uint8
+{
+	Sum,
+	Min,
+	Max,
+	/** Number of matching payloads; PropertyName is ignored. */
+	Count
+};
+
+/**
+ * A value kept up to date over the payloads of a grid, e.g. "TotalWeight" = Sum of FMyItemData::Weight scaled by
+ * the stack quantity. Payloads that are not PayloadStruct (or a child of it) are skipped.
+ */
+USTRUCT(BlueprintType)
+struct FOBGridAggregateSpec
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Aggregate")
+	FName AggregateName = NAME_None;
+
+	/** Null matches any payload that has PropertyName. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Aggregate")
+	TObjectPtr<UScriptStruct> PayloadStruct = nullptr;
+
+	/** Numeric or bool property of the payload struct. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Aggregate")
+	FName PropertyName = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Aggregate")
+	EOBGridAggregateOp Op = EOBGridAggregateOp::Sum;
+
+	/** Multiply by FOBGridStackablePayload::Quantity, so a stack of 20 counts 20 times. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Aggregate")
+	bool bScaleByQuantity = false;
+};
+
+/** Refuses adds and payload changes that would raise an aggregate above MaxValue. */
+USTRUCT(BlueprintType)
+struct FOBGridCapacityRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Aggregate")
+	FName AggregateName = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Aggregate")
+	double MaxValue = 0.0;
+};
+
+/**
+ * Registered aggregates of one item state, updated per item add/remove/payload change so reads are O(1).
+ * Sums and counts are running totals; Min/Max keep a count per distinct value and only rescan those distinct
+ * values when the current extreme leaves.
+ */
+class OBGRIDINVENTORY_API FOBGridAggregateSet
+{
+public:
+	/** Adds or replaces an aggregate. Existing payloads are folded in by the caller through AddPayload. */
+	void Register(const FOBGridAggregateSpec& Spec);
+	bool Unregister(FName AggregateName);
+	bool IsEmpty() const { return Aggregates.IsEmpty(); }
+	const TArray<FOBGridAggregateSpec>& GetSpecs() const { return Specs; }
+
+	/** Folds a payload into every aggregate. Pass AggregateIndex to only update that one. */
+	void AddPayload(FConstStructView Payload, int32 AggregateIndex = INDEX_NONE);
+	void RemovePayload(FConstStructView Payload);
+	void ResetValues();
+
+	/** @return False if the aggregate is unknown, or is a Min/Max without any matching payload. */
+	bool GetValue(FName AggregateName, double& OutValue) const;
+
+	/**
+	 * Checks the rules against the values the change would produce. A change that does not raise an aggregate is
+	 * always allowed, so an inventory already over a limit (rules tightened at runtime) can still be edited.
+	 * @param OldPayload The payload being replaced, an empty view for an add.
+	 * @return False with the first violated rule in OutViolatedRule.
+	 */
+	bool CheckRules(const TArray<FOBGridCapacityRule>& Rules, FConstStructView NewPayload,
+					FConstStructView OldPayload, FName& OutViolatedRule) const;
+
+	/**
+	 * How much of Quantity the rules accept for a stack of UnitPayload, counting quantity-scaled Sum and Count
+	 * aggregates. Used to clamp stack merges before any stack is touched.
+	 */
+	int32 GetAcceptableQuantity(const TArray<FOBGridCapacityRule>& Rules, FConstStructView UnitPayload,
+								int32 Quantity) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+	/** Keeps the payload structs of the specs alive. Called by the owning item state. */
+	void AddReferencedObjects(FReferenceCollector& Collector);
+
+private:
+	struct FAggregate
+	{
+		double Sum = 0.0;
+		int32 NumContributors = 0;
+		double Extreme = 0.0;
+
+		/** Min/Max only: value -> number of payloads holding it. */
+		TMap<double, int32> ValueCounts;
+	};
+
+	int32 FindAggregateIndex(FName AggregateName) const;
+
+	/** @return False if the payload does not take part in the aggregate. */
+	bool GetContribution(int32 AggregateIndex, FConstStructView Payload, double& OutValue) const;
+	const FProperty* ResolveProperty(int32 AggregateIndex, const UScriptStruct* PayloadStruct) const;
+	void Apply(int32 AggregateIndex, double Value, bool bAdd);
+	double GetCurrentValue(int32 AggregateIndex) const;
+
+	TArray<FOBGridAggregateSpec> Specs;
+	TArray<FAggregate> Aggregates;
+
+	/** Per aggregate, payload struct -> resolved property (null when the struct does not take part). */
+	mutable TArray<TMap<TObjectKey<UScriptStruct>, const FProperty*>> PropertyCache;
+};
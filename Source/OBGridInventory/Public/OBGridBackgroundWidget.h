@@ -6,6 +6,43 @@
 #include "Blueprint/UserWidget.h"
 #include "OBGridBackgroundWidget.generated.h"
 
+/** A named rectangular part of the grid (e.g. one pouch of a chest rig). Items never cross section borders. */
+USTRUCT(BlueprintType)
+struct FOBGridSection
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config")
+	FName SectionName = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config",
+		meta = (ClampMin = "0", UIMin = "0"))
+	int32 Row = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config",
+		meta = (ClampMin = "0", UIMin = "0"))
+	int32 Column = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config",
+		meta = (ClampMin = "1", UIMin = "1"))
+	int32 NumRows = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config",
+		meta = (ClampMin = "1", UIMin = "1"))
+	int32 NumColumns = 1;
+
+	bool ContainsCell(const int32 CheckRow, const int32 CheckCol) const
+	{
+		return CheckRow >= Row && CheckRow < Row + NumRows && CheckCol >= Column && CheckCol < Column + NumColumns;
+	}
+
+	bool operator==(const FOBGridSection& Other) const
+	{
+		return SectionName == Other.SectionName && Row == Other.Row && Column == Other.Column &&
+			NumRows == Other.NumRows && NumColumns == Other.NumColumns;
+	}
+};
+
 USTRUCT(BlueprintType)
 struct FOBGridInventoryConfig
 {
@@ -42,6 +79,17 @@ struct FOBGridInventoryConfig
 			"Show name of widget owner in top left corner during editor/designer time"))
 	bool bIsShowNameOnTopLeftCorner = true;
 
+	/**
+	 * Optional sections. When set, only cells inside a section are usable and items must fit inside a single
+	 * section. When empty, the whole grid is one section.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config")
+	TArray<FOBGridSection> Sections;
+
+	/** Cells (X = Column, Y = Row) that are masked out of the grid. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config")
+	TArray<FIntPoint> DisabledCells;
+
 	FOBGridInventoryConfig() = default;
 
 	FOBGridInventoryConfig(const int32 InNumRows, const int32 InNumColumns, const float InCellSize,
@@ -55,6 +103,43 @@ struct FOBGridInventoryConfig
 		GridLineThickness = FMath::Max(GridLineThickness, 0.0f);
 		bIsShowNameOnTopLeftCorner = true;
 	}
+
+	bool HasCustomLayout() const
+	{
+		return !Sections.IsEmpty() || !DisabledCells.IsEmpty();
+	}
+
+	/**
+	 * Builds the per-cell section index (row-major) for a grid of the given size.
+	 * Disabled cells and cells outside every section get INDEX_NONE. Leaves the array empty for plain grids.
+	 */
+	void BuildCellSections(const int32 InNumRows, const int32 InNumColumns, TArray<int32>& OutCellSections) const
+	{
+		OutCellSections.Reset();
+		if (!HasCustomLayout()) return;
+
+		OutCellSections.Init(Sections.IsEmpty() ? 0 : INDEX_NONE, InNumRows * InNumColumns);
+		for (int32 SectionIndex = Sections.Num() - 1; SectionIndex >= 0; --SectionIndex)
+		{
+			// Iterate backwards so the first declared section wins where sections overlap.
+			const FOBGridSection& Section = Sections[SectionIndex];
+			for (int32 r = FMath::Max(Section.Row, 0); r < FMath::Min(Section.Row + Section.NumRows, InNumRows); ++r)
+			{
+				for (int32 c = FMath::Max(Section.Column, 0);
+					 c < FMath::Min(Section.Column + Section.NumColumns, InNumColumns); ++c)
+				{
+					OutCellSections[r * InNumColumns + c] = SectionIndex;
+				}
+			}
+		}
+		for (const FIntPoint& Cell : DisabledCells)
+		{
+			if (Cell.X >= 0 && Cell.X < InNumColumns && Cell.Y >= 0 && Cell.Y < InNumRows)
+			{
+				OutCellSections[Cell.Y * InNumColumns + Cell.X] = INDEX_NONE;
+			}
+		}
+	}
 };
 
 /**
@@ -101,4 +186,8 @@ private:
 
 	UPROPERTY(Transient)
 	float BorderLineThickness = 2.0f;
+
+	/** Per-cell section index (INDEX_NONE = masked). Empty for a plain rectangular grid. */
+	UPROPERTY(Transient)
+	TArray<int32> CellSections;
 };
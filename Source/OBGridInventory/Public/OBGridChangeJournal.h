@@ -0,0 +1,97 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBGridChangeJournal.generated.h"
+
+UENUM(BlueprintType)
+enum class EOBGridChangeType : uint8
+{
+	Added,
+	Removed,
+	Moved,
+	PayloadChanged,
+	/** The whole grid was rebuilt; consumers must resync from the current state. */
+	Reset,
+	/** Dimensions, sections or cell mask changed. RowSpan/ColumnSpan hold the new grid size. */
+	LayoutChanged,
+	/**
+	 * A tentative move of the item was reserved or resolved. The placement fields hold the cells the reservation
+	 * holds (or released); UOBGridItemState::IsItemPending tells which.
+	 */
+	PendingChanged
+};
+
+/**
+ * Compact delta record. Identifies items by ItemId instead of widget pointers and does not copy payloads;
+ * consumers that need the payload can fetch it from the grid when they apply the record.
+ */
+USTRUCT(BlueprintType)
+struct FOBGridChangeRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Journal")
+	int64 Sequence = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Journal")
+	EOBGridChangeType Type = EOBGridChangeType::Added;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Journal")
+	int32 ItemId = INDEX_NONE;
+
+	// Placement after the change (before it, for Removed).
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Journal")
+	int32 Row = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Journal")
+	int32 Column = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Journal")
+	int32 RowSpan = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Journal")
+	int32 ColumnSpan = 0;
+};
+
+/**
+ * Monotonic, bounded journal of grid changes. Sequence numbers start at 1 and never repeat, so a consumer only
+ * has to remember the last sequence it applied. When a consumer falls further behind than the retained window,
+ * GetChangesSince reports it so the consumer can do a full resync instead.
+ */
+class OBGRIDINVENTORY_API FOBGridChangeJournal
+{
+public:
+	explicit FOBGridChangeJournal(const int32 InCapacity = 1024)
+	{
+		SetCapacity(InCapacity);
+	}
+
+	void SetCapacity(const int32 InCapacity)
+	{
+		Capacity = FMath::Max(InCapacity, 1);
+	}
+
+	int64 Append(EOBGridChangeType Type, int32 ItemId, int32 Row, int32 Column, int32 RowSpan, int32 ColumnSpan);
+
+	/**
+	 * Collects every record newer than SinceSequence.
+	 * @return False if records after SinceSequence were already discarded (consumer must resync).
+	 */
+	bool GetChangesSince(int64 SinceSequence, TConstArrayView<FOBGridChangeRecord>& OutRecords) const;
+
+	/** Sequence of the most recent record, 0 if nothing was ever recorded. */
+	int64 GetLatestSequence() const { return NextSequence - 1; }
+
+	/** Oldest sequence still retained, 0 if the journal is empty. */
+	int64 GetOldestSequence() const { return Records.IsEmpty() ? 0 : Records[0].Sequence; }
+
+	SIZE_T GetAllocatedSize() const { return Records.GetAllocatedSize(); }
+
+private:
+	// Records are kept contiguous; trimming happens in batches once twice the capacity is reached.
+	TArray<FOBGridChangeRecord> Records;
+	int64 NextSequence = 1;
+	int32 Capacity = 1024;
+};
@@ -0,0 +1,78 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBGridOccupancy.h"
+#include "Blueprint/UserWidget.h"
+#include "StructUtils/InstancedStruct.h"
+#include "Tasks/Task.h"
+#include "OBGridFitSolver.generated.h"
+
+/** One item the caller wants to fit into a set of containers. */
+USTRUCT(BlueprintType)
+struct FOBGridFitRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Fit")
+	FInstancedStruct ItemPayload;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Fit", meta = (ClampMin = "1", UIMin = "1"))
+	int32 ItemRows = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Fit", meta = (ClampMin = "1", UIMin = "1"))
+	int32 ItemCols = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Fit")
+	TSubclassOf<UUserWidget> CustomItemWidgetClass;
+};
+
+/** Where a single request ends up: container index and top-left cell. */
+USTRUCT(BlueprintType)
+struct FOBGridFitPlacement
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Fit")
+	int32 RequestIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Fit")
+	int32 ContainerIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Fit")
+	int32 Row = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Fit")
+	int32 Column = 0;
+};
+
+/** Result of the feasibility solver. Placements are listed in request order when the plan is feasible. */
+USTRUCT(BlueprintType)
+struct FOBGridPlacementPlan
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Fit")
+	bool bFeasible = false;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Fit")
+	TArray<FOBGridFitPlacement> Placements;
+};
+
+/**
+ * Side-effect-free "can all of these items fit into these containers" solver.
+ * It only works on copies of FOBGridOccupancy, so it never touches UMG and is safe to run on worker threads.
+ * Several item/container orderings are tried in parallel; the first feasible strategy (in a fixed priority
+ * order) wins, which keeps results deterministic.
+ */
+class OBGRIDINVENTORY_API FOBGridFitSolver
+{
+public:
+	static FOBGridPlacementPlan Solve(const TArray<FOBGridOccupancy>& Containers,
+									  const TArray<FOBGridFitRequest>& Items);
+
+	/** Runs Solve on the task graph. Inputs are copied into the task. */
+	static UE::Tasks::TTask<FOBGridPlacementPlan> SolveAsync(TArray<FOBGridOccupancy> Containers,
+															 TArray<FOBGridFitRequest> Items);
+};
@@ -5,61 +5,49 @@
 #include "CoreMinimal.h"
 #include "InstancedStruct.h" // Required for FInstancedStruct
 #include "OBGridBackgroundWidget.h"
+#include "OBGridChangeJournal.h"
+#include "OBGridFitSolver.h"
+#include "OBGridItemState.h"
+#include "OBGridItemTypes.h"
+#include "OBGridItemVisual.h"
+#include "OBGridMemoryStats.h"
+#include "OBGridMoveAuthority.h"
+#include "OBGridOccupancy.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/SizeBox.h"
+#include "Containers/Ticker.h"
 #include "StructUtils/InstancedStruct.h"
 #include "OBGridInventoryWidget.generated.h"
 
-class UGridPanel;
+class UOBGridPanel;
 class UOverlay;
+class UPanelSlot;
+class UPanelWidget;
 
-/**
- * Structure representing the complete metadata of an item within the grid.
- * It now encapsulates position, size, the source data asset, and a flexible custom data payload.
- */
-USTRUCT(BlueprintType)
-struct FOBGridItemInfo
+/** What gamepad navigation does when it reaches the edge of the grid. */
+UENUM(BlueprintType)
+enum class EOBGridNavigationEdge : uint8
 {
-	GENERATED_BODY()
-
-	// Row of the top-left corner
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="OB|Grid Item")
-	int32 Row = 0;
-
-	// Column of the top-left corner
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="OB|Grid Item")
-	int32 Column = 0;
-
-	// Number of rows the item occupies
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="OB|Grid Item")
-	int32 RowSpan = 1;
-
-	// Number of columns the item occupies
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="OB|Grid Item")
-	int32 ColumnSpan = 1;
-
-	/** A flexible payload for any custom, dynamic data (e.g., durability, stats). */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item")
-	FInstancedStruct ItemPayload;
-
-	/** The last recorded central position of the item. */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item")
-	FVector2D LastCenter = FVector2D(-1.0f, -1.0f);
-
-	FOBGridItemInfo() = default;
-
-	FOBGridItemInfo(const int32 InRow, const int32 InCol, const int32 InRowSpan, const int32 InColSpan,
-					const FInstancedStruct& InPayload)
-		: Row(InRow), Column(InCol), RowSpan(InRowSpan), ColumnSpan(InColSpan), ItemPayload(InPayload)
-	{
-	}
+	/** Focus stays on the current cell. */
+	Stop,
+	/** Continue from the opposite edge, on the same row/column. */
+	Wrap,
+	/** Let Slate move focus out of the grid. */
+	Escape
+};
 
-	bool ContainsCell(const int32 CheckRow, const int32 CheckCol) const
-	{
-		return CheckRow >= Row && CheckRow < (Row + RowSpan) &&
-			CheckCol >= Column && CheckCol < (Column + ColumnSpan);
-	}
+/** Why a full item widget is alive in painted item mode. An item keeps its widget while any reason is set. */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EOBGridItemWidgetDemand : uint8
+{
+	None = 0 UMETA(Hidden),
+	Hover = 1 << 0,
+	Focus = 1 << 1,
+	Drag = 1 << 2,
+	/** Explicit request, e.g. from the widget-returning add functions. Lasts until released. */
+	Pinned = 1 << 3
 };
+ENUM_CLASS_FLAGS(EOBGridItemWidgetDemand);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnOBGridItemAdded, UUserWidget*, ItemWidget, const FOBGridItemInfo&,
 											 ItemInfo);
@@ -69,22 +57,62 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnOBGridItemRemoved, UUserWidget*,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnOBGridItemMoved, UUserWidget*, ItemWidget, const FOBGridItemInfo&,
 											 NewItemInfo);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnOBGridItemOverflowed, UUserWidget*, ItemWidget,
+											 const FOBGridItemInfo&, ItemInfo);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnOBGridItemPayloadChanged, UUserWidget*, ItemWidget,
+											 const FOBGridItemInfo&, ItemInfo);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnOBGridItemPendingChanged, UUserWidget*, ItemWidget,
+											   const FOBGridItemInfo&, ItemInfo, bool, bPending);
+
+class UOBGridInventoryWidget;
+
+/** Native, per-frame coalesced notification carrying every journal record produced since the previous one. */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnOBGridChangesFlushed, UOBGridInventoryWidget* /*Grid*/,
+									 TConstArrayView<FOBGridChangeRecord> /*Records*/);
+
 UCLASS()
 class OBGRIDINVENTORY_API UOBGridInventoryWidget : public UUserWidget
 {
 	GENERATED_BODY()
 
 public:
+	UOBGridInventoryWidget(const FObjectInitializer& ObjectInitializer);
+
 	// --- Overrides ---
 	virtual void NativeConstruct() override;
 	virtual void NativePreConstruct() override;
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 	virtual void NativeOnInitialized() override;
+	virtual void BeginDestroy() override;
 	virtual FNavigationReply NativeOnNavigation(const FGeometry& MyGeometry,
 												const FNavigationEvent& InNavigationEvent,
 												const FNavigationReply& InDefaultReply) override;
+	virtual FReply NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
+	virtual void NativeOnRemovedFromFocusPath(const FFocusEvent& InFocusEvent) override;
 
 public:
+	// --- Item State ---
+	/**
+	 * Presents another item state, e.g. the one of the main inventory grid in a HUD quick-view. Every view bound
+	 * to a state shows the same items; the state's dimensions and layout replace this widget's GridConfig.
+	 * Pass null to go back to this widget's own state.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|State")
+	void SetItemState(UOBGridItemState* NewItemState);
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|State")
+	UOBGridItemState* GetItemState() const { return ItemState; }
+
+	/**
+	 * Applies the state changes this view has not presented yet. Views that are not on screen skip widget work
+	 * until their next tick; call this to catch up right away. Operations called on this widget always do.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|State")
+	void ApplyStateChanges();
+
 	// --- Grid Configuration ---
 	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Configuration")
 	virtual void SetGridRows(const int32 NewGridRows);
@@ -92,23 +120,142 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Configuration")
 	virtual void SetGridColumns(const int32 NewGridColumns);
 
+	/**
+	 * Resizes the grid at runtime while keeping placed items. Only the added/removed rows and columns are
+	 * touched; items that end up out of bounds are handled according to OutOfBoundsPolicy.
+	 * @return False if the resize was refused (nothing changed).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Configuration")
+	bool ResizeGrid(int32 NewRows, int32 NewColumns,
+					EOBGridResizePolicy OutOfBoundsPolicy = EOBGridResizePolicy::Repack);
+
+	/**
+	 * Replaces the section layout and cell mask. Refused if a placed item would end up on a masked cell or
+	 * across a section border.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Configuration")
+	bool SetGridLayout(const TArray<FOBGridSection>& NewSections, const TArray<FIntPoint>& NewDisabledCells);
+
+	/** Masks a single cell in or out. Disabling an occupied cell is refused. */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Configuration")
+	bool SetCellEnabled(int32 Row, int32 Column, bool bEnabled);
+
 	// --- Item Management ---
 	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items",
 		meta=(DisplayName="Add Item Widget (Auto-Placement)"))
 	UUserWidget* AddItemWidget(const FInstancedStruct& ItemPayload = FInstancedStruct(), const int32 ItemRows = 1,
 							   const int32 ItemCols = 1, TSubclassOf<UUserWidget> CustomItemWidgetClass = nullptr);
 
+	/** Auto-placement restricted to one named section (e.g. a single pouch of a rig). */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items",
+		meta=(DisplayName="Add Item Widget to Section"))
+	UUserWidget* AddItemWidgetToSection(FName SectionName, const FInstancedStruct& ItemPayload = FInstancedStruct(),
+										const int32 ItemRows = 1, const int32 ItemCols = 1,
+										TSubclassOf<UUserWidget> CustomItemWidgetClass = nullptr);
+
 	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items", meta=(DisplayName="Add Item Widget at Slot"))
 	UUserWidget* AddItemWidgetAt(const FInstancedStruct& ItemPayload = FInstancedStruct(), int32 ItemRows = 1,
 								 const int32 ItemCols = 1, const int32 RowTopLeft = 1, const int32 ColTopLeft = 1,
 								 TSubclassOf<UUserWidget> CustomItemWidgetClass = nullptr);
 
+	/**
+	 * Stack-aware add. Tops up existing partial stacks with the same StackKey first, then splits the overflow
+	 * into new placements of at most MaxStackSize. Non-stackable payloads fall back to AddItemWidget, one item
+	 * of quantity 1 per unit of Quantity.
+	 * @return True if the whole quantity was accommodated.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items", meta=(DisplayName="Add Stackable Item"))
+	bool AddStackableItem(const FInstancedStruct& ItemPayload, FOBGridStackAddResult& OutResult,
+						  const int32 ItemRows = 1, const int32 ItemCols = 1,
+						  TSubclassOf<UUserWidget> CustomItemWidgetClass = nullptr);
+
+	/** Replaces the payload of a placed item and notifies the item widget. */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items")
+	bool SetItemPayload(UUserWidget* ItemWidget, const FInstancedStruct& NewPayload);
+
+	// --- Items by Id ---
+	// Same operations addressed by ItemId. They never force a widget into existence, which is what painted item
+	// mode relies on; without painting every item has its widget anyway.
+
+	/** @return The new ItemId, or INDEX_NONE if the item could not be placed. */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items by Id")
+	int32 AddItem(const FInstancedStruct& ItemPayload, int32 ItemRows = 1, int32 ItemCols = 1,
+				  TSubclassOf<UUserWidget> CustomItemWidgetClass = nullptr);
+
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items by Id")
+	int32 AddItemAt(const FInstancedStruct& ItemPayload, int32 ItemRows, int32 ItemCols, int32 RowTopLeft,
+					int32 ColTopLeft, TSubclassOf<UUserWidget> CustomItemWidgetClass = nullptr);
+
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items by Id")
+	bool RemoveItem(int32 ItemId);
+
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items by Id")
+	bool MoveItem(int32 ItemId, int32 NewRowTopLeft, int32 NewColTopLeft);
+
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items by Id")
+	bool SetItemPayloadById(int32 ItemId, const FInstancedStruct& NewPayload);
+
+	/**
+	 * Moves the item this frame and asks MoveAuthority to decide; the item stays pending (and its previous cells
+	 * held) until the authority confirms or rolls the move back. Without an authority this is MoveItem.
+	 * @return False if the move is not possible or the item already has a move pending.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Reservations")
+	bool RequestItemMove(int32 ItemId, int32 NewRowTopLeft, int32 NewColTopLeft);
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Reservations")
+	bool IsItemPending(int32 ItemId) const;
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Items by Id")
+	bool GetItemInfoById(int32 ItemId, FOBGridItemInfo& OutItemInfo) const;
+
+	/** @return The item covering the cell, or INDEX_NONE. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Items by Id")
+	int32 GetItemIdAtCell(int32 Row, int32 Column) const;
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Items by Id")
+	int32 GetItemIdForWidget(UUserWidget* ItemWidget) const;
+
+	/** @return The item's widget, or null if it has none right now (painted item mode). */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Items by Id")
+	UUserWidget* GetItemWidgetById(int32 ItemId) const;
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Items by Id")
+	void GetAllItemIds(TArray<int32>& OutItemIds) const;
+
+	int32 GetNumItems() const { return ItemState->GetNumItems(); }
+
+	// --- Painted Items ---
+	/** True when items are drawn by the UOBGridPanel and only get a widget on demand. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Painted Items")
+	bool IsPaintingItems() const;
+
+	/**
+	 * Makes sure the item has a full widget and records why. Hover and focus are handled by the grid; call this
+	 * with Drag when a drag starts (and ReleaseItemWidget when it ends) so the dragged widget stays alive.
+	 * Without painting this just returns the item's widget.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Painted Items")
+	UUserWidget* AcquireItemWidget(int32 ItemId, EOBGridItemWidgetDemand Reason);
+
+	/** Clears a reason set by AcquireItemWidget; the widget goes back to the pool once no reason is left. */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Painted Items")
+	void ReleaseItemWidget(int32 ItemId, EOBGridItemWidgetDemand Reason);
+
+	/**
+	 * Fills the icon, quantity text and rarity border drawn for an item in painted mode. The default shows the
+	 * quantity of stackable payloads; override it to pull the icon and rarity out of your payload.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "Grid Inventory|Painted Items")
+	void ResolveItemVisual(const FOBGridItemInfo& ItemInfo, FOBGridItemVisual& OutVisual) const;
+
 	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items")
 	bool RemoveItemWidget(UUserWidget* ItemWidgetToRemove);
 
 	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items")
 	void ClearGrid();
 
+	/** Goes through RequestItemMove, so drag and drop is optimistic once a MoveAuthority is set. */
 	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Items")
 	bool MoveItemWidget(UUserWidget* ItemWidgetToMove, int32 NewRowTopLeft, int32 NewColTopLeft);
 
@@ -116,6 +263,18 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Querying")
 	bool IsAreaClear(int32 TopLeftRow, int32 TopLeftCol, int32 ItemRows, int32 ItemCols) const;
 
+	/** @return The widget of the item covering the cell (not only its top-left), or null. O(1). */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Querying")
+	UUserWidget* GetItemWidgetAtCell(int32 Row, int32 Column) const;
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Querying")
+	bool IsCellEnabled(int32 Row, int32 Column) const;
+
+	/** @return Name of the section containing the cell, None if the cell is masked or the grid has no sections. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Querying")
+	FName GetSectionAt(int32 Row, int32 Column) const;
+
+	/** Widgets of the items that currently have one: every item, unless painting. */
 	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Querying")
 	void GetAllItemWidgets(TArray<UUserWidget*>& OutItemWidgets) const;
 
@@ -130,8 +289,90 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Querying")
 	bool GetItemPayload(UUserWidget* ItemWidget, FInstancedStruct& OutItemPayload) const;
 
+	/**
+	 * Copies every change recorded after SinceSequence. 0 asks for the whole history, which fails once the journal
+	 * has trimmed its oldest records; pass GetOldestChangeSequence() - 1 to get everything still retained.
+	 * @return False if part of that range was already discarded; the consumer should resync from the grid.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Journal")
+	bool GetChangesSince(int64 SinceSequence, TArray<FOBGridChangeRecord>& OutRecords) const;
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Journal")
+	int64 GetLatestChangeSequence() const { return ItemState->GetChangeJournal().GetLatestSequence(); }
+
+	/** Oldest change still retained by the journal, 0 if it is empty. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Journal")
+	int64 GetOldestChangeSequence() const { return ItemState->GetChangeJournal().GetOldestSequence(); }
+
+	const FOBGridChangeJournal& GetChangeJournal() const { return ItemState->GetChangeJournal(); }
+
+	/** Cell occupancy of this grid. Copy it to run queries off the game thread. */
+	const FOBGridOccupancy& GetOccupancy() const { return ItemState->GetOccupancy(); }
+
+	/**
+	 * Approximate memory held by this grid: item/dummy widgets, lookup maps, payloads and bookkeeping.
+	 * @param bIncludeItemState Adds the items, payloads and bookkeeping of the bound state. Pass false for a view
+	 * whose state was already counted with another view.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Diagnostics")
+	FOBGridMemoryStats GetMemoryStats(bool bIncludeItemState = true) const;
+
+	// --- Hit Testing ---
+	/**
+	 * Converts an absolute (screen/desktop space) position to the cell under it, using the cached geometry of
+	 * ItemGridPanel. Lets hover/drop code resolve cells without relying on Slate hit-testing of filler cells.
+	 * @return False if the position is outside the grid.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Hit Testing")
+	bool AbsoluteToCell(const FVector2D& AbsolutePosition, int32& OutRow, int32& OutColumn) const;
+
+	/** Same as AbsoluteToCell for a position local to ItemGridPanel. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Hit Testing")
+	bool LocalToCell(const FVector2D& LocalPosition, int32& OutRow, int32& OutColumn) const;
+
+	/** Rect of a cell (or of a span starting at it) in ItemGridPanel local space. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Hit Testing")
+	void GetCellLocalRect(int32 Row, int32 Column, FVector2D& OutTopLeft, FVector2D& OutSize, int32 RowSpan = 1,
+						  int32 ColumnSpan = 1) const;
+
+	/** @return The item under an absolute position, or null. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Hit Testing")
+	UUserWidget* GetItemWidgetAtPosition(const FVector2D& AbsolutePosition) const;
+
+	// --- Navigation ---
+	/** Moves gamepad focus to the item (or dummy cell) at the given cell and makes it the navigation origin. */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Navigation")
+	bool SetFocusedCell(int32 Row, int32 Column);
+
+	/** Cell used as the origin of the next grid navigation (X = Column, Y = Row). */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Navigation")
+	FIntPoint GetFocusedCell() const { return FocusedCell; }
+
+	// --- Planning ---
+	/**
+	 * Checks whether every requested item fits into the given containers without touching them.
+	 * The solver runs on copies of the containers' occupancy; use FOBGridFitSolver::SolveAsync from native code
+	 * to run it on a worker thread. The capacity rules of the containers are then checked on the plan it found:
+	 * a plan that breaks one is reported as not feasible.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Planning")
+	static bool CanFitAll(const TArray<UOBGridInventoryWidget*>& Containers, const TArray<FOBGridFitRequest>& Items,
+						  FOBGridPlacementPlan& OutPlan);
+
+	/**
+	 * Applies a plan produced by CanFitAll/FOBGridFitSolver. All placements are validated against the current
+	 * state and capacity rules first; either every item is added or none is.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Planning")
+	static bool CommitPlacementPlan(const TArray<UOBGridInventoryWidget*>& Containers,
+									const TArray<FOBGridFitRequest>& Items, const FOBGridPlacementPlan& Plan,
+									TArray<UUserWidget*>& OutItemWidgets);
+
 public:
 	// --- Events ---
+	// In painted item mode the ItemWidget argument is null for items that have no widget at that moment;
+	// ItemInfo.ItemId and the change journal identify the item. Each view fires them when it applies the change,
+	// so a view that is not on screen fires them once it becomes visible (or on ApplyStateChanges).
 	UPROPERTY(BlueprintAssignable, Category = "Grid Inventory|Events")
 	FOnOBGridItemAdded OnItemAdded;
 
@@ -141,13 +382,34 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Grid Inventory|Events")
 	FOnOBGridItemMoved OnItemMoved;
 
+	UPROPERTY(BlueprintAssignable, Category = "Grid Inventory|Events")
+	FOnOBGridItemPayloadChanged OnItemPayloadChanged;
+
+	/** A tentative move of the item started (bPending) or was confirmed or rolled back. */
+	UPROPERTY(BlueprintAssignable, Category = "Grid Inventory|Events")
+	FOnOBGridItemPendingChanged OnItemPendingChanged;
+
+	/** Fired by ResizeGrid with the Overflow policy, after the item was removed. Only on the resizing view. */
+	UPROPERTY(BlueprintAssignable, Category = "Grid Inventory|Events")
+	FOnOBGridItemOverflowed OnItemOverflowed;
+
+	/** Fired at most once per frame with the journal records the item state produced during that frame. */
+	FOnOBGridChangesFlushed OnChangesFlushed;
+
 protected:
 	// --- Internal ---
 	bool ValidateAddItemInputs(int32 ItemRows, int32 ItemCols, TSubclassOf<UUserWidget> CustomItemWidgetClass) const;
 
-	UUserWidget* AddItemWidgetInternal(const FInstancedStruct& ItemPayload, const int32 ItemRows,
-									   const int32 ItemCols, const int32 RowTopLeft, const int32 ColTopLeft,
-									   TSubclassOf<UUserWidget> CustomItemWidgetClass);
+	/**
+	 * Checks that the plan places each request exactly once, and every placement against the live cells and the
+	 * capacity rules of its container.
+	 */
+	static bool ValidatePlacementPlan(const TArray<UOBGridInventoryWidget*>& Containers,
+									  const TArray<FOBGridFitRequest>& Items, const FOBGridPlacementPlan& Plan);
+
+	/** Distinct item states of the containers, and per container the index of its state (INDEX_NONE if null). */
+	static void GatherContainerStates(const TArray<UOBGridInventoryWidget*>& Containers,
+									  TArray<int32>& OutStateIndices, TArray<const UOBGridItemState*>& OutStates);
 
 protected:
 	// --- Configuration Properties ---
@@ -160,43 +422,176 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid Inventory|Config")
 	TSubclassOf<UUserWidget> DummyCellWidgetClass;
 
+	/** Policy used by SetGridRows/SetGridColumns when the new size leaves items out of bounds. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Inventory|Config")
+	EOBGridResizePolicy DefaultResizePolicy = EOBGridResizePolicy::Repack;
+
+	/**
+	 * Filler cells are HitTestInvisible by default so Slate's hit-test grid only holds real items;
+	 * use AbsoluteToCell to resolve empty cells. Enable if dummy widgets must react to the mouse themselves.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid Inventory|Config")
+	bool bDummyCellsHitTestable = false;
+
+	/** Behaviour of directional navigation at the grid edges. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Inventory|Navigation")
+	EOBGridNavigationEdge NavigationEdgeBehavior = EOBGridNavigationEdge::Stop;
+
+	/**
+	 * When true, navigation stops on empty cells that have a dummy widget. Otherwise (or without
+	 * DummyCellWidgetClass) it skips empty cells and goes straight to the next item in that direction.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Inventory|Navigation")
+	bool bNavigateEmptyCells = true;
+
+	/**
+	 * Draw items in the UOBGridPanel (icon, quantity, rarity border, see ResolveItemVisual) instead of giving each
+	 * one a widget. A full item widget only exists while an item is hovered, focused, dragged or pinned, and dummy
+	 * cells are not created. Requires ItemGridPanel to be a UOBGridPanel.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid Inventory|Config")
+	bool bUsePaintedItems = false;
+
+	/** Painted mode: released item widgets kept for reuse instead of being recreated on the next hover. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid Inventory|Config",
+		meta = (ClampMin = "0", UIMin = "0", EditCondition = "bUsePaintedItems"))
+	int32 MaxPooledItemWidgets = 4;
+
+	/** Number of change records this widget's own state keeps before the oldest ones are discarded. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid Inventory|Config",
+		meta = (ClampMin = "16", UIMin = "16"))
+	int32 ChangeJournalCapacity = 1024;
+
+	/** Registered on this widget's own state at initialization; read them through GetItemState(). */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid Inventory|Aggregates")
+	TArray<FOBGridAggregateSpec> Aggregates;
+
+	/** Applied to this widget's own state at initialization; adds that would break one are refused. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid Inventory|Aggregates")
+	TArray<FOBGridCapacityRule> CapacityRules;
+
+	/** Publish thread-safe snapshots of this widget's own state; read them through GetItemState()->GetSnapshot(). */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid Inventory|Snapshots")
+	bool bPublishSnapshots = false;
+
+	/** Share one payload instance between equal items of this widget's own state (large stashes, loot piles). */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid Inventory|Config")
+	bool bInternPayloads = false;
+
+	/**
+	 * Decides the moves made through RequestItemMove (and MoveItemWidget). Null applies them directly; use
+	 * UOBGridSimulatedMoveAuthority to try optimistic moves against a local server with latency.
+	 */
+	UPROPERTY(EditAnywhere, Instanced, BlueprintReadWrite, Category = "Grid Inventory|Reservations")
+	TObjectPtr<UOBGridMoveAuthority> MoveAuthority;
+
 	// --- Bound Widgets ---
-	UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
+	// Background, size box and overlay are only needed with a UGridPanel; a UOBGridPanel sizes itself and
+	// draws its own grid lines.
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
 	TObjectPtr<UOBGridBackgroundWidget> GridBackground = nullptr;
 
-	UPROPERTY(BlueprintReadOnly, meta = (BindWidget), Category = "Grid Inventory")
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional), Category = "Grid Inventory")
 	TObjectPtr<USizeBox> GridSizeBox = nullptr;
 
-	UPROPERTY(BlueprintReadOnly, meta = (BindWidget), Category = "Grid Inventory")
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional), Category = "Grid Inventory")
 	TObjectPtr<UOverlay> GridOverlay = nullptr;
 
+	/** Either a UOBGridPanel (preferred) or a legacy UGridPanel. */
 	UPROPERTY(BlueprintReadOnly, meta = (BindWidget), Category = "Grid Inventory")
-	TObjectPtr<UGridPanel> ItemGridPanel = nullptr;
+	TObjectPtr<UPanelWidget> ItemGridPanel = nullptr;
 
 private:
 	// --- Runtime Data ---
+	/** Model presented by this view: OwnedItemState unless SetItemState bound a shared one. */
+	UPROPERTY(Transient)
+	TObjectPtr<UOBGridItemState> ItemState;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UOBGridItemState> OwnedItemState;
+
+	/** ItemId -> top-left cell (X = Column, Y = Row) of the items this view presents. */
+	TMap<int32, FIntPoint> PresentedItems;
+
+	/** Dimensions the panel tracks and dummy cells were built for (X = Columns, Y = Rows). */
+	FIntPoint PresentedGridSize = FIntPoint::ZeroValue;
+
+	/** Last journal sequence of ItemState this view has applied. */
+	int64 AppliedSequence = 0;
+
+	/** Set while changes are waiting for the view to be on screen again. */
+	bool bPresentationDirty = false;
+	bool bIsApplyingChanges = false;
+	uint64 LastPresentedFrame = 0;
+
+	/** Items that currently have a widget: all of them unless painting. */
+	UPROPERTY(Transient)
+	TMap<int32, TObjectPtr<UUserWidget>> ItemWidgetsById;
+
 	UPROPERTY(Transient)
-	TMap<TObjectPtr<UUserWidget>, FOBGridItemInfo> PlacedItemInfoMap;
+	TMap<TObjectPtr<UUserWidget>, int32> ItemIdsByWidget;
 
 	UPROPERTY(Transient)
 	TMap<FIntPoint, TWeakObjectPtr<UUserWidget>> DummyCellWidgetsMap;
 
+	/** Reverse of DummyCellWidgetsMap, so the focused dummy is found without scanning every cell. */
+	TMap<TWeakObjectPtr<UUserWidget>, FIntPoint> DummyCellsByWidget;
+
+	/** Painted mode: why each materialized item widget is alive. */
+	TMap<int32, EOBGridItemWidgetDemand> WidgetDemandsById;
+
+	/** Painted mode: released item widgets, reused by class. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UUserWidget>> PooledItemWidgets;
+
+	int32 HoveredItemId = INDEX_NONE;
+	int32 FocusedItemId = INDEX_NONE;
+
+	int64 LastFlushedSequence = 0;
+	FTSTicker::FDelegateHandle PendingFlushHandle;
+
 	float CurrentGridScale = 1.0f;
+	FIntPoint FocusedCell = FIntPoint::ZeroValue;
 	FVector2D LastKnownAllocatedSize = FVector2D(-1.0f, -1.0f);
 
 private:
 	// --- Helpers ---
-	bool FindFreeSlot(int32 ItemRows, int32 ItemCols, int32& OutRow, int32& OutCol) const;
-	bool IsAreaClearForMove(int32 TopLeftRow, int32 TopLeftCol, int32 ItemRows, int32 ItemCols,
-							UUserWidget* IgnoredWidget) const;
+	void HandleItemStateChanged(UOBGridItemState* ChangedState);
+	bool IsPresentationLive() const;
+	void ApplyChange(const FOBGridChangeRecord& Record);
+	bool PresentItem(int32 ItemId);
+	bool UnpresentItem(int32 ItemId, int32 RowSpan, int32 ColumnSpan);
+	/** Applies GridConfig written while off screen to the owned state; a refused part is logged and undone. */
+	void ReconcileConfigWithState();
+	FIntPoint SyncLayoutFromState();
+	void ApplyStateLayout();
+	/** Recreates every widget without events; only for a new state, whose item ids mean nothing to this view. */
+	void RebuildPresentation();
+	/** Brings the presented items in line with the state when the records in between are gone, with events. */
+	void ReconcilePresentation();
+	UUserWidget* CreateItemWidgetFor(int32 ItemId);
+	void DestroyItemWidgetFor(int32 ItemId, bool bReturnToPool);
+	UOBGridPanel* GetPaintingPanel() const;
+	FOBGridPaintedItem MakePaintedItem(const FOBGridItemInfo& ItemInfo) const;
+	void SetHoveredItem(int32 ItemId);
+	void SetFocusedItem(int32 ItemId);
+	UUserWidget* ResolveNavigationWidget(int32 Row, int32 Column);
+	/** Cell of the item or dummy widget holding the user's focus; OutCell is left alone if there is none. */
+	bool FindUserFocusedCell(uint32 UserIndex, FIntPoint& OutCell) const;
+	bool FindNavigationTarget(EUINavigation Direction, FIntPoint& InOutCell, bool& bOutEscaped) const;
 	void UpdateGridBackground() const;
 	bool CalculateCurrentScale(const FGeometry& CurrentGeometry);
 	void UpdateSizeBoxOverride() const;
 	void RecalculateScaleAndRefreshLayout(const FGeometry& CurrentGeometry);
 	void UpdateDummyCells();
+	void RefreshDummyCellsInArea(int32 TopLeftRow, int32 TopLeftCol, int32 NumAreaRows, int32 NumAreaCols);
+	void SetTrackFills(int32 OldRows, int32 OldColumns, int32 NewRows, int32 NewColumns) const;
+	UPanelSlot* AddChildToCell(UWidget* Content, int32 Row, int32 Column, int32 RowSpan, int32 ColumnSpan) const;
+	static bool SetChildCell(const UWidget* Content, int32 Row, int32 Column);
 	bool TryAddDummyWidgetAt(int32 Row, int32 Column);
 	void RemoveDummyWidgetAt(const FIntPoint& Coord);
 	void SetupGridPanelDimensions();
+	bool FlushPendingChanges(float DeltaTime);
 };
 
 
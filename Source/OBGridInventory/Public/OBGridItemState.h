@@ -0,0 +1,352 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBGridAggregates.h"
+#include "OBGridBackgroundWidget.h"
+#include "OBGridChangeJournal.h"
+#include "OBGridItemTypes.h"
+#include "OBGridOccupancy.h"
+#include "OBGridPayloadPool.h"
+#include "OBGridSnapshot.h"
+#include "Containers/Ticker.h"
+#include "UObject/Object.h"
+#include "OBGridItemState.generated.h"
+
+class UOBGridItemState;
+class UUserWidget;
+
+/** Fired once per operation that changed the state, after the operation is complete. */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnOBGridItemStateChanged, UOBGridItemState* /*State*/);
+
+/**
+ * Item model of a grid: placed items by id, cell occupancy, section layout, stack index and change journal.
+ * Every UOBGridInventoryWidget presents one; several widgets can bind to the same state (full grid, HUD quick-view,
+ * trade preview) and each applies the journal records it has not seen yet. Mutating the state directly, rather
+ * than through one of the views, lets every hidden view defer its widget work.
+ */
+UCLASS(BlueprintType)
+class OBGRIDINVENTORY_API UOBGridItemState : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// --- Layout ---
+	/** Sets the dimensions and layout and discards every item. */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|State")
+	void Initialize(int32 NumRows, int32 NumColumns, const TArray<FOBGridSection>& Sections,
+					const TArray<FIntPoint>& DisabledCells);
+
+	/**
+	 * Resizes the grid keeping placed items; items that end up out of bounds follow OutOfBoundsPolicy.
+	 * Items removed by the Overflow policy are copied to OutOverflowedItems.
+	 * @return False if the resize was refused (nothing changed).
+	 */
+	bool Resize(int32 NewRows, int32 NewColumns, EOBGridResizePolicy OutOfBoundsPolicy,
+				TArray<FOBGridItemInfo>& OutOverflowedItems);
+
+	/** Replaces the section layout and cell mask. Refused if a placed item would be masked or cross a section. */
+	bool SetLayout(const TArray<FOBGridSection>& NewSections, const TArray<FIntPoint>& NewDisabledCells);
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|State")
+	int32 GetNumRows() const { return Occupancy.GetNumRows(); }
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|State")
+	int32 GetNumColumns() const { return Occupancy.GetNumColumns(); }
+
+	const TArray<FOBGridSection>& GetSections() const { return Sections; }
+	const TArray<FIntPoint>& GetDisabledCells() const { return DisabledCells; }
+
+	/** @return Index of the named section, INDEX_NONE if there is none. */
+	int32 FindSectionIndex(FName SectionName) const;
+
+	// --- Items ---
+	// Widget classes are only stored for the views; null means "the view's ItemWidgetClass".
+
+	/** Places an item at a cell. @return The new ItemId, or INDEX_NONE if the area is not clear. */
+	int32 AddItemAt(const FInstancedStruct& ItemPayload, int32 ItemRows, int32 ItemCols, int32 RowTopLeft,
+					int32 ColTopLeft, TSubclassOf<UUserWidget> WidgetClass = nullptr);
+
+	/** First-fit placement, optionally restricted to one section. @return The new ItemId, or INDEX_NONE. */
+	int32 AddItem(const FInstancedStruct& ItemPayload, int32 ItemRows, int32 ItemCols,
+				  TSubclassOf<UUserWidget> WidgetClass = nullptr, int32 SectionIndex = INDEX_NONE);
+
+	/**
+	 * Tops up partial stacks with the same StackKey, then places the overflow as new stacks when bAllowNewStacks.
+	 * Fills the ids of OutResult; widgets are left to the views.
+	 * @return True if the whole quantity was accommodated.
+	 */
+	bool AddStackableItem(const FInstancedStruct& ItemPayload, int32 ItemRows, int32 ItemCols,
+						  TSubclassOf<UUserWidget> WidgetClass, bool bAllowNewStacks,
+						  FOBGridStackAddResult& OutResult);
+
+	bool RemoveItem(int32 ItemId);
+	bool MoveItem(int32 ItemId, int32 NewRowTopLeft, int32 NewColTopLeft);
+	bool SetItemPayload(int32 ItemId, const FInstancedStruct& NewPayload);
+
+	/** Removes every item, one Removed record each. */
+	void ClearItems();
+
+	// --- Reservations ---
+	// Optimistic moves for server-authoritative grids. Resize and SetLayout are refused rather than relocate, drop
+	// or mask a pending item or the cells it holds; removing or authoritatively moving (MoveItem) a pending item
+	// drops its reservation.
+
+	/**
+	 * Moves the item at once and holds the cells it left as FOBGridOccupancy::ReservedCell, excluded from every
+	 * placement query, until ConfirmReservation or RollbackReservation. A rollback therefore never fails.
+	 * @return The reservation id, INDEX_NONE if the move is not possible or the item already has one pending.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Reservations")
+	int32 ReserveMove(int32 ItemId, int32 NewRowTopLeft, int32 NewColTopLeft);
+
+	/** The authority accepted the move: frees the held cells. */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Reservations")
+	bool ConfirmReservation(int32 ReservationId);
+
+	/** The authority refused the move: puts the item back on the held cells. */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Reservations")
+	bool RollbackReservation(int32 ReservationId);
+
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Reservations")
+	void RollbackAllReservations();
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Reservations")
+	bool IsItemPending(const int32 ItemId) const { return ReservationIdsByItem.Contains(ItemId); }
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Reservations")
+	int32 GetNumReservations() const { return Reservations.Num(); }
+
+	// --- Payload Interning ---
+	/**
+	 * Lets items with equal payloads share one immutable instance, so a stash of identical ammo or materials pays
+	 * for each distinct variant once. Changing an item's payload interns the new value (copy-on-write). Interned
+	 * items leave ItemPayload empty: read payloads through FOBGridItemInfo::GetPayload(). Switching converts the
+	 * items already placed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|State")
+	void SetInternPayloads(bool bEnable);
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|State")
+	bool IsInterningPayloads() const { return bInternPayloads; }
+
+	/** Distinct payload instances shared by the items, 0 when not interning. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|State")
+	int32 GetNumDistinctPayloads() const { return PayloadPool.GetNumDistinct(); }
+
+	// --- Queries ---
+	/** Interned items keep ItemPayload empty; use WithOwnedPayload() before handing one to Blueprint. */
+	const FOBGridItemInfo* FindItem(const int32 ItemId) const { return Items.Find(ItemId); }
+	const TMap<int32, FOBGridItemInfo>& GetItems() const { return Items; }
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|State")
+	int32 GetNumItems() const { return Items.Num(); }
+
+	/** @return The item covering the cell, or INDEX_NONE. */
+	int32 GetItemIdAtCell(int32 Row, int32 Column) const;
+
+	/** @return The widget class the item was added with, null for the view's default. */
+	TSubclassOf<UUserWidget> GetItemWidgetClass(int32 ItemId) const;
+
+	/** Cell occupancy. Copy it to run queries off the game thread. */
+	const FOBGridOccupancy& GetOccupancy() const { return Occupancy; }
+
+	// --- Aggregates ---
+	/**
+	 * Registers a value kept up to date over the payloads (total weight, total value, best rarity...).
+	 * Reading it is O(1); registering folds in the items already placed. Replaces an aggregate of the same name.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Aggregates")
+	void RegisterAggregate(const FOBGridAggregateSpec& Spec);
+
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Aggregates")
+	bool UnregisterAggregate(FName AggregateName);
+
+	/** @return False if the aggregate is unknown, or is a Min/Max and no item matches it. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Aggregates")
+	bool GetAggregateValue(FName AggregateName, double& OutValue) const;
+
+	/**
+	 * Adds, stack merges and payload changes that would raise a ruled aggregate above its MaxValue are refused
+	 * before anything is placed, so no view ever creates a widget for them.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Aggregates")
+	void SetCapacityRules(const TArray<FOBGridCapacityRule>& NewRules) { CapacityRules = NewRules; }
+
+	const TArray<FOBGridCapacityRule>& GetCapacityRules() const { return CapacityRules; }
+
+	/** Current aggregate values. Copy them to project a batch of adds against the capacity rules. */
+	const FOBGridAggregateSet& GetAggregates() const { return Aggregates; }
+
+	/** Whether the capacity rules accept one more item with this payload. Free space is not checked. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Aggregates")
+	bool CanAcceptPayload(const FInstancedStruct& ItemPayload, FName& OutViolatedRule) const;
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Aggregates")
+	int32 GetNumOccupiedCells() const { return NumOccupiedCells; }
+
+	/** Free cells that are not masked out. */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Aggregates")
+	int32 GetNumFreeCells() const { return NumEnabledCells - NumOccupiedCells; }
+
+	/**
+	 * Largest free rectangle (by area) inside a single section. Computed on the first read after the occupancy
+	 * changed (O(rows * columns)), then cached; writes only mark it stale.
+	 * @return Its area, 0 if the grid is full.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Aggregates")
+	int32 GetLargestFreeRect(int32& OutRow, int32& OutColumn, int32& OutNumRows, int32& OutNumColumns) const;
+
+	// --- Snapshots ---
+	/**
+	 * Publishes an immutable snapshot for queries on worker threads, once per frame (on the next core ticker tick)
+	 * after operations changed the state, so a burst of changes costs one copy. Snapshots may therefore lag the
+	 * state by up to a frame; compare GetVersion() with the journal to tell. Off by default since each one copies
+	 * the occupancy; enabling publishes the current state at once. Object references inside payloads are not kept
+	 * alive by snapshots.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Grid Inventory|Snapshots")
+	void SetPublishSnapshots(bool bEnable);
+
+	UFUNCTION(BlueprintPure, Category = "Grid Inventory|Snapshots")
+	bool IsPublishingSnapshots() const { return bPublishSnapshots; }
+
+	/** Any thread. Latest published snapshot, up to a frame behind the state; null while publishing is off. */
+	FOBGridSnapshotPtr GetSnapshot() const { return SnapshotChannel->Acquire(); }
+
+	/** Any thread. Worker threads should keep the channel rather than the state: it outlives the state. */
+	TSharedRef<const FOBGridSnapshotChannel, ESPMode::ThreadSafe> GetSnapshotChannel() const
+	{
+		return SnapshotChannel;
+	}
+
+	// --- Journal ---
+	void SetJournalCapacity(const int32 Capacity) { ChangeJournal.SetCapacity(Capacity); }
+	const FOBGridChangeJournal& GetChangeJournal() const { return ChangeJournal; }
+
+	/** Memory held by the item map and the lookups built on it. Payload contents are not included. */
+	SIZE_T GetItemMapAllocatedSize() const;
+
+	/** Views listen to this and pull the new records from the journal. */
+	FOnOBGridItemStateChanged OnChanged;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+	virtual void BeginDestroy() override;
+
+private:
+	/** Holds OnChanged back until the outermost operation is done, so listeners never see a half-applied change. */
+	struct FChangeScope
+	{
+		explicit FChangeScope(UOBGridItemState& InState);
+		~FChangeScope();
+		UOBGridItemState& State;
+	};
+
+	/** Cells held for a rollback: the area the item left. */
+	struct FReservation
+	{
+		int32 ItemId = INDEX_NONE;
+		int32 Row = 0;
+		int32 Column = 0;
+		int32 RowSpan = 1;
+		int32 ColumnSpan = 1;
+
+		FIntRect GetArea() const { return FIntRect(Column, Row, Column + ColumnSpan, Row + RowSpan); }
+	};
+
+	int32 AddItemInternal(const FInstancedStruct& ItemPayload, int32 ItemRows, int32 ItemCols, int32 RowTopLeft,
+						  int32 ColTopLeft, TSubclassOf<UUserWidget> WidgetClass);
+	void ApplyCellLayout(FOBGridOccupancy& TargetOccupancy, const TArray<FOBGridSection>& InSections,
+						 const TArray<FIntPoint>& InDisabledCells) const;
+	void IndexPartialStack(int32 ItemId, FConstStructView ItemPayload);
+	void UnindexPartialStack(int32 ItemId, FConstStructView ItemPayload);
+
+	/** Stores the payload on the item, interned or not. */
+	void StorePayload(FOBGridItemInfo& ItemInfo, const FInstancedStruct& Payload);
+	void RecordChange(EOBGridChangeType Type, const FOBGridItemInfo& ItemInfo);
+	void RecordLayoutChange();
+	void RecordPendingChange(const FReservation& Reservation);
+
+	/** Logs the refusal. OldPayload is the payload being replaced, an empty view for an add. */
+	bool PassesCapacityRules(FConstStructView NewPayload, FConstStructView OldPayload) const;
+
+	/** IsAreaClear for the item, counting the cells its own pending reservation holds as free. */
+	bool IsAreaClearForItem(const FOBGridOccupancy& InOccupancy, int32 ItemId, int32 RowTopLeft, int32 ColTopLeft,
+							int32 RowSpan, int32 ColumnSpan) const;
+
+	/** Frees the held cells and forgets the reservation; the item stays where it is. */
+	bool ReleaseReservation(int32 ReservationId);
+	void DropItemReservation(int32 ItemId);
+
+	/** Recounts the enabled cells after a layout change. */
+	void RefreshEnabledCellCount();
+
+	/** Publishes the current state, or a null snapshot when publishing is off. */
+	void PublishSnapshot();
+	void ScheduleSnapshotPublish();
+	bool PublishScheduledSnapshot(float DeltaTime);
+	void BuildSnapshot(FOBGridSnapshot& Snapshot);
+
+	/** ItemId -> item. The source of truth for every view bound to this state. */
+	UPROPERTY(Transient)
+	TMap<int32, FOBGridItemInfo> Items;
+
+	/** Widget class per item, only when one was given at add time. */
+	UPROPERTY(Transient)
+	TMap<int32, TSubclassOf<UUserWidget>> WidgetClassesById;
+
+	UPROPERTY(Transient)
+	TArray<FOBGridSection> Sections;
+
+	UPROPERTY(Transient)
+	TArray<FIntPoint> DisabledCells;
+
+	/** Cell -> ItemId lookup kept in sync with Items. */
+	FOBGridOccupancy Occupancy;
+
+	int32 NextItemId = 1;
+
+	FOBGridChangeJournal ChangeJournal;
+	int64 NotifiedSequence = 0;
+	int32 ChangeScopeDepth = 0;
+
+	/** StackKey -> placed stacks that still have room. Lets stack merging skip scanning every payload. */
+	TMap<FName, TArray<int32>> PartialStackIndex;
+
+	// --- Aggregates ---
+	FOBGridAggregateSet Aggregates;
+
+	UPROPERTY(Transient)
+	TArray<FOBGridCapacityRule> CapacityRules;
+
+	int32 NumEnabledCells = 0;
+	int32 NumOccupiedCells = 0;
+
+	/** Recomputed by GetLargestFreeRect, only if the occupancy changed since the last read. */
+	mutable FIntRect LargestFreeRect;
+	mutable bool bLargestFreeRectDirty = true;
+
+	// --- Reservations ---
+	TMap<int32, FReservation> Reservations;
+	TMap<int32, int32> ReservationIdsByItem;
+	int32 NextReservationId = 1;
+
+	// --- Payload Interning ---
+	bool bInternPayloads = false;
+	FOBGridPayloadPool PayloadPool;
+
+	// --- Snapshots ---
+	bool bPublishSnapshots = false;
+	TSharedRef<FOBGridSnapshotChannel, ESPMode::ThreadSafe> SnapshotChannel =
+		MakeShared<FOBGridSnapshotChannel, ESPMode::ThreadSafe>();
+
+	/**
+	 * ItemId -> payload shared by successive snapshots, dropped when the item changes payload or leaves.
+	 * Interned items hand their shared instance to snapshots directly and never appear here.
+	 */
+	TMap<int32, FConstSharedStruct> SnapshotPayloads;
+
+	/** Set while a publication waits for the next tick, to batch the changes of a frame or for a free slot. */
+	FTSTicker::FDelegateHandle SnapshotPublishHandle;
+};
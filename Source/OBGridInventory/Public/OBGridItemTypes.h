@@ -0,0 +1,184 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StructUtils/InstancedStruct.h"
+#include "StructUtils/SharedStruct.h"
+#include "StructUtils/StructView.h"
+#include "OBGridItemTypes.generated.h"
+
+class UUserWidget;
+
+/**
+ * Structure representing the complete metadata of an item within the grid.
+ * It now encapsulates position, size, the source data asset, and a flexible custom data payload.
+ */
+USTRUCT(BlueprintType)
+struct FOBGridItemInfo
+{
+	GENERATED_BODY()
+
+	// Row of the top-left corner
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="OB|Grid Item")
+	int32 Row = 0;
+
+	// Column of the top-left corner
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="OB|Grid Item")
+	int32 Column = 0;
+
+	// Number of rows the item occupies
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="OB|Grid Item")
+	int32 RowSpan = 1;
+
+	// Number of columns the item occupies
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="OB|Grid Item")
+	int32 ColumnSpan = 1;
+
+	/** A flexible payload for any custom, dynamic data (e.g., durability, stats). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item")
+	FInstancedStruct ItemPayload;
+
+	/**
+	 * Set instead of ItemPayload by item states that intern payloads: one immutable instance shared by every item
+	 * with an equal payload. Native code reads the payload through GetPayload(); copies handed to Blueprint go
+	 * through WithOwnedPayload().
+	 */
+	UPROPERTY(Transient)
+	FConstSharedStruct SharedPayload;
+
+	/** Id assigned by the owning grid, unique within that grid. Also stored in its occupancy cells. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="OB|Grid Item")
+	int32 ItemId = INDEX_NONE;
+
+	/** The last recorded central position of the item. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item")
+	FVector2D LastCenter = FVector2D(-1.0f, -1.0f);
+
+	FOBGridItemInfo() = default;
+
+	FOBGridItemInfo(const int32 InRow, const int32 InCol, const int32 InRowSpan, const int32 InColSpan,
+					const FInstancedStruct& InPayload)
+		: Row(InRow), Column(InCol), RowSpan(InRowSpan), ColumnSpan(InColSpan), ItemPayload(InPayload)
+	{
+	}
+
+	/** The payload, wherever it is stored. */
+	FConstStructView GetPayload() const
+	{
+		return SharedPayload.IsValid() ? FConstStructView(SharedPayload) : FConstStructView(ItemPayload);
+	}
+
+	/** Editable copy of the payload, e.g. to change it and pass it to SetItemPayload. */
+	FInstancedStruct CopyPayload() const
+	{
+		if (!SharedPayload.IsValid()) return ItemPayload;
+		FInstancedStruct Copy;
+		Copy.InitializeAs(SharedPayload.GetScriptStruct(), SharedPayload.GetMemory());
+		return Copy;
+	}
+
+	/** Copy that owns its payload in ItemPayload, as Blueprint expects. */
+	FOBGridItemInfo WithOwnedPayload() const
+	{
+		FOBGridItemInfo Copy = *this;
+		if (SharedPayload.IsValid())
+		{
+			Copy.ItemPayload = CopyPayload();
+			Copy.SharedPayload = FConstSharedStruct();
+		}
+		return Copy;
+	}
+
+	bool ContainsCell(const int32 CheckRow, const int32 CheckCol) const
+	{
+		return CheckRow >= Row && CheckRow < (Row + RowSpan) &&
+			CheckCol >= Column && CheckCol < (Column + ColumnSpan);
+	}
+};
+
+/**
+ * Base payload for stackable items (ammo, currency...).
+ * Derive your payload struct from this one to let the grid merge stacks natively.
+ */
+USTRUCT(BlueprintType)
+struct FOBGridStackablePayload
+{
+	GENERATED_BODY()
+
+	/** Items sharing the same key can be merged into the same stack. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item")
+	FName StackKey = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item", meta = (ClampMin = "0", UIMin = "0"))
+	int32 Quantity = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item", meta = (ClampMin = "1", UIMin = "1"))
+	int32 MaxStackSize = 1;
+
+	bool IsStackable() const
+	{
+		return !StackKey.IsNone() && MaxStackSize > 1;
+	}
+
+	bool IsPartialStack() const
+	{
+		return IsStackable() && Quantity < MaxStackSize;
+	}
+};
+
+/** What happens to items that no longer fit when the grid shrinks. */
+UENUM(BlueprintType)
+enum class EOBGridResizePolicy : uint8
+{
+	/** Relocate them into free cells of the new bounds; the resize fails if one cannot be relocated. */
+	Repack,
+	/** Refuse any resize that would leave an item out of bounds. */
+	Reject,
+	/** Remove them from the grid and hand them to OnItemOverflowed. */
+	Overflow
+};
+
+/** Quantity that was merged into an already placed stack. */
+USTRUCT(BlueprintType)
+struct FOBGridStackMerge
+{
+	GENERATED_BODY()
+
+	/** Null for a painted item without a widget. */
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Item")
+	TObjectPtr<UUserWidget> ItemWidget = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Item")
+	int32 ItemId = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Item")
+	int32 QuantityAdded = 0;
+};
+
+/** Detailed outcome of a stack-aware add: what was merged versus what was placed as new stacks. */
+USTRUCT(BlueprintType)
+struct FOBGridStackAddResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Item")
+	TArray<FOBGridStackMerge> MergedStacks;
+
+	/** Widgets of the new stacks; painted items without a widget only appear in PlacedItemIds. */
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Item")
+	TArray<TObjectPtr<UUserWidget>> PlacedWidgets;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Item")
+	TArray<int32> PlacedItemIds;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Item")
+	int32 QuantityMerged = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Item")
+	int32 QuantityPlaced = 0;
+
+	/** Quantity that could neither be merged nor placed (grid full). */
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Item")
+	int32 QuantityRemaining = 0;
+};
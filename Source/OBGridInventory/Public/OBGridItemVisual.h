@@ -0,0 +1,85 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fonts/SlateFontInfo.h"
+#include "Styling/SlateBrush.h"
+#include "OBGridItemVisual.generated.h"
+
+/** What the grid paints for an item that has no widget of its own (painted item mode). */
+USTRUCT(BlueprintType)
+struct FOBGridItemVisual
+{
+	GENERATED_BODY()
+
+	/** Drawn over the item rect, inset by the style's icon padding. Nothing is drawn for NoDrawType. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual")
+	FSlateBrush Icon;
+
+	/** Drawn in the bottom-right corner, typically the stack quantity. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual")
+	FText QuantityText;
+
+	/** Rarity/quality frame around the item rect. Transparent draws no frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual")
+	FLinearColor BorderColor = FLinearColor::Transparent;
+
+	/** Fill behind the icon. Transparent draws nothing. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual")
+	FLinearColor BackgroundColor = FLinearColor::Transparent;
+};
+
+/** Shared look of painted items; sizes are in unscaled cell units and get scaled like the cells. */
+USTRUCT(BlueprintType)
+struct FOBGridPaintedItemStyle
+{
+	GENERATED_BODY()
+
+	FOBGridPaintedItemStyle();
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual")
+	FSlateFontInfo QuantityFont;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual")
+	FLinearColor QuantityColor = FLinearColor::White;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual", meta = (ClampMin = "0"))
+	float IconPadding = 4.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual", meta = (ClampMin = "0"))
+	float QuantityPadding = 3.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual", meta = (ClampMin = "0"))
+	float BorderThickness = 2.0f;
+
+	/** White box brush used for backgrounds. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="OB|Grid Item Visual")
+	FSlateBrush BackgroundBrush;
+};
+
+/** An item painted by SOBGridPanel, at its cell rect. */
+USTRUCT()
+struct FOBGridPaintedItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Row = 0;
+
+	UPROPERTY()
+	int32 Column = 0;
+
+	UPROPERTY()
+	int32 RowSpan = 1;
+
+	UPROPERTY()
+	int32 ColumnSpan = 1;
+
+	UPROPERTY()
+	FOBGridItemVisual Visual;
+
+	/** Set while a full item widget stands in for this item. */
+	UPROPERTY()
+	bool bHidden = false;
+};
@@ -27,9 +27,28 @@ public:
 	/**
 	 * Called by the Grid Inventory right after this widget is created and placed.
 	 * This is the primary entry point for the widget to receive its data and initialize its appearance.
+	 * In painted item mode a pooled widget is reused for another item, and this is called again with its data.
 	 *
 	 * @param ItemInfo The complete information about the item, including its data source and custom payload.
 	 */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Grid Item Widget")
 	void OnItemInitialized(const FOBGridItemInfo& ItemInfo);
+
+	/**
+	 * Called when the payload of an already placed item changes (e.g. a stack was topped up).
+	 *
+	 * @param ItemInfo The item information carrying the updated payload.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Grid Item Widget")
+	void OnItemPayloadChanged(const FOBGridItemInfo& ItemInfo);
+
+	/**
+	 * Called when a tentative move of this item starts and when the authority confirms or rolls it back.
+	 * A rollback moves the item back before this is called with bPending false.
+	 *
+	 * @param ItemInfo The item information at its current placement.
+	 * @param bPending True while the move waits for the authority (dim the widget, show a spinner...).
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Grid Item Widget")
+	void OnItemPendingChanged(const FOBGridItemInfo& ItemInfo, bool bPending);
 };
@@ -0,0 +1,69 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBGridMemoryStats.generated.h"
+
+struct FConstStructView;
+
+/**
+ * Approximate memory cost of one grid widget. Widget bytes cover the UObjects of each widget and its widget tree
+ * (Slate-side allocations are not included); container bytes are allocated sizes.
+ */
+USTRUCT(BlueprintType)
+struct FOBGridMemoryStats
+{
+	GENERATED_BODY()
+
+	/** Placed items, with or without a widget. */
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Memory")
+	int32 NumItems = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Memory")
+	int32 NumItemWidgets = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Memory")
+	int32 NumDummyWidgets = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Memory")
+	int64 ItemWidgetBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Memory")
+	int64 DummyWidgetBytes = 0;
+
+	/** Item records and the widget/stack lookups built on top of them. */
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Memory")
+	int64 ItemMapBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Memory")
+	int64 DummyMapBytes = 0;
+
+	/** Heap owned by item payloads: the instanced struct allocations plus their strings and arrays. */
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Memory")
+	int64 PayloadHeapBytes = 0;
+
+	/** Occupancy grid and change journal. */
+	UPROPERTY(BlueprintReadOnly, Category="OB|Grid Memory")
+	int64 BookkeepingBytes = 0;
+
+	int64 GetTotalBytes() const
+	{
+		return ItemWidgetBytes + DummyWidgetBytes + ItemMapBytes + DummyMapBytes + PayloadHeapBytes +
+			BookkeepingBytes;
+	}
+
+	FOBGridMemoryStats& operator+=(const FOBGridMemoryStats& Other);
+};
+
+namespace OBGridMemory
+{
+	/** Heap owned by a payload: its struct allocation plus top-level strings and arrays. */
+	OBGRIDINVENTORY_API int64 GetPayloadHeapBytes(FConstStructView Payload);
+
+	/** Adds the items, payloads (shared ones once), item map and bookkeeping of an item state. */
+	OBGRIDINVENTORY_API void AddItemStateStats(const class UOBGridItemState& State, FOBGridMemoryStats& InOutStats);
+
+	/** UObject memory of a widget and of every widget in its widget tree. */
+	OBGRIDINVENTORY_API int64 GetWidgetBytes(const class UUserWidget* Widget);
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/Object.h"
+#include "OBGridMoveAuthority.generated.h"
+
+class UOBGridItemState;
+
+/**
+ * Decides tentative moves made through UOBGridInventoryWidget::RequestItemMove. The item has already moved on
+ * the client when RequestMove is called; forward it to the server (an RPC on your inventory component) and answer
+ * with State->ConfirmReservation or State->RollbackReservation once the authoritative result arrives.
+ */
+UCLASS(Abstract, Blueprintable, EditInlineNew, DefaultToInstanced)
+class OBGRIDINVENTORY_API UOBGridMoveAuthority : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintNativeEvent, Category = "Grid Inventory|Reservations")
+	void RequestMove(UOBGridItemState* State, int32 ReservationId, int32 ItemId, int32 NewRowTopLeft,
+					 int32 NewColTopLeft);
+};
+
+/**
+ * Local stand-in for a server: answers every request after a simulated round trip, in request order, and refuses
+ * a share of them to exercise rollbacks. OB.Grid.SimulatedLatency overrides the latency of every instance.
+ */
+UCLASS(EditInlineNew)
+class OBGRIDINVENTORY_API UOBGridSimulatedMoveAuthority : public UOBGridMoveAuthority
+{
+	GENERATED_BODY()
+
+public:
+	/** Round trip, in seconds. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Inventory|Reservations", meta = (ClampMin = "0"))
+	float LatencySeconds = 0.15f;
+
+	/** Random extra delay, in seconds. Results still arrive in request order, as over a reliable channel. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Inventory|Reservations", meta = (ClampMin = "0"))
+	float JitterSeconds = 0.0f;
+
+	/** Share of requests the simulated server refuses. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Inventory|Reservations",
+		meta = (ClampMin = "0", ClampMax = "1"))
+	float RejectionChance = 0.0f;
+
+	virtual void RequestMove_Implementation(UOBGridItemState* State, int32 ReservationId, int32 ItemId,
+											int32 NewRowTopLeft, int32 NewColTopLeft) override;
+	virtual void BeginDestroy() override;
+
+private:
+	struct FPendingRequest
+	{
+		TWeakObjectPtr<UOBGridItemState> State;
+		int32 ReservationId = INDEX_NONE;
+		double DueSeconds = 0.0;
+	};
+
+	bool ResolveDueRequests(float DeltaTime);
+
+	TArray<FPendingRequest> PendingRequests;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,115 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Plain cell occupancy of a grid: each cell stores the id of the item covering it, or 0 when free.
+ * An optional per-cell section layout masks cells out and keeps items inside a single section.
+ * It has no UObject dependency so it can be copied and queried freely on worker threads.
+ */
+struct OBGRIDINVENTORY_API FOBGridOccupancy
+{
+	static constexpr int32 FreeCell = 0;
+
+	/** Held by a pending reservation: not free, but not covered by an item either. */
+	static constexpr int32 ReservedCell = INDEX_NONE - 1;
+
+	FOBGridOccupancy() = default;
+	FOBGridOccupancy(const int32 InNumRows, const int32 InNumColumns)
+	{
+		Reset(InNumRows, InNumColumns);
+	}
+
+	/** Resizes the grid and frees every cell. */
+	void Reset(int32 InNumRows, int32 InNumColumns);
+
+	/** Resizes the grid keeping the cells that stay in bounds. New cells are free. Clears the section layout. */
+	void Resize(int32 InNumRows, int32 InNumColumns);
+
+	/**
+	 * Sets the row-major section index of every cell (INDEX_NONE = masked out).
+	 * An empty array means the whole grid is a single section.
+	 */
+	void SetCellSections(TArray<int32> InCellSections);
+
+	/** @return Section index of the cell, INDEX_NONE if masked out or out of bounds. */
+	int32 GetCellSection(const int32 Row, const int32 Column) const
+	{
+		if (!IsValidCell(Row, Column)) return INDEX_NONE;
+		return CellSections.IsEmpty() ? 0 : CellSections[Row * NumColumns + Column];
+	}
+
+	bool IsCellEnabled(const int32 Row, const int32 Column) const
+	{
+		return GetCellSection(Row, Column) != INDEX_NONE;
+	}
+
+	int32 GetNumRows() const { return NumRows; }
+	int32 GetNumColumns() const { return NumColumns; }
+
+	bool IsValidCell(const int32 Row, const int32 Column) const
+	{
+		return Row >= 0 && Row < NumRows && Column >= 0 && Column < NumColumns;
+	}
+
+	bool IsInBounds(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows, const int32 ItemCols) const
+	{
+		return ItemRows > 0 && ItemCols > 0 && IsValidCell(TopLeftRow, TopLeftCol) &&
+			TopLeftRow + ItemRows <= NumRows && TopLeftCol + ItemCols <= NumColumns;
+	}
+
+	/** @return Item id covering the cell, FreeCell if empty, ReservedCell if held, INDEX_NONE if out of bounds. */
+	int32 GetCell(const int32 Row, const int32 Column) const
+	{
+		return IsValidCell(Row, Column) ? Cells[Row * NumColumns + Column] : INDEX_NONE;
+	}
+
+	/**
+	 * True if the area is inside the grid, inside a single section and only covers free cells
+	 * (or cells owned by IgnoredItemId).
+	 */
+	bool IsAreaClear(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows, const int32 ItemCols,
+					 const int32 IgnoredItemId = FreeCell) const
+	{
+		return IsAreaClear(TopLeftRow, TopLeftCol, ItemRows, ItemCols, IgnoredItemId, FIntRect());
+	}
+
+	/** Same, also counting the reserved cells inside HeldArea (X = column, Y = row, max exclusive) as free. */
+	bool IsAreaClear(int32 TopLeftRow, int32 TopLeftCol, int32 ItemRows, int32 ItemCols, int32 IgnoredItemId,
+					 const FIntRect& HeldArea) const;
+
+	/** First-fit scan, row by row, for an area of the given size. Optionally restricted to one section. */
+	bool FindFreeSlot(int32 ItemRows, int32 ItemCols, int32& OutRow, int32& OutCol,
+					  int32 SectionIndex = INDEX_NONE) const;
+
+	/** Marks the area as owned by ItemId (FreeCell clears it). The area is clamped to the grid. */
+	void Fill(int32 TopLeftRow, int32 TopLeftCol, int32 ItemRows, int32 ItemCols, int32 ItemId);
+
+	void Clear(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows, const int32 ItemCols)
+	{
+		Fill(TopLeftRow, TopLeftCol, ItemRows, ItemCols, FreeCell);
+	}
+
+	/** Sets the cells of the area that hold OldValue to NewValue. @return Number of cells changed. */
+	int32 Replace(int32 TopLeftRow, int32 TopLeftCol, int32 ItemRows, int32 ItemCols, int32 OldValue,
+				  int32 NewValue);
+
+	/** Number of free cells that are not masked out. */
+	int32 CountFreeCells() const;
+
+	/**
+	 * Largest rectangle, by area, of free cells inside a single section (min = top-left column/row, max exclusive).
+	 * Empty when no cell is free. Runs in O(rows * columns).
+	 */
+	FIntRect FindLargestFreeRect() const;
+
+	SIZE_T GetAllocatedSize() const { return Cells.GetAllocatedSize() + CellSections.GetAllocatedSize(); }
+
+private:
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	TArray<int32> Cells;
+	TArray<int32> CellSections;
+};
@@ -0,0 +1,86 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBGridBackgroundWidget.h"
+#include "OBGridItemVisual.h"
+#include "Components/PanelWidget.h"
+#include "OBGridPanel.generated.h"
+
+class SOBGridPanel;
+class UOBGridPanelSlot;
+
+/**
+ * UMG wrapper of SOBGridPanel. Use it as the ItemGridPanel of a UOBGridInventoryWidget instead of a UGridPanel:
+ * it needs no row/column fills, no SizeBox and can draw the grid lines itself.
+ */
+UCLASS()
+class OBGRIDINVENTORY_API UOBGridPanel : public UPanelWidget
+{
+	GENERATED_BODY()
+
+public:
+	UOBGridPanel();
+
+	UFUNCTION(BlueprintCallable, Category = "Widget")
+	UOBGridPanelSlot* AddChildToCell(UWidget* Content, int32 Row, int32 Column, int32 RowSpan = 1,
+									 int32 ColumnSpan = 1);
+
+	/** Pushes dimensions, cell size, line style and section layout to the panel. */
+	UFUNCTION(BlueprintCallable, Category = "Widget")
+	void SetGridConfig(const FOBGridInventoryConfig& InGridConfig);
+
+	UFUNCTION(BlueprintCallable, Category = "Widget")
+	void SetGridScale(float InGridScale);
+
+	UFUNCTION(BlueprintPure, Category = "Widget")
+	float GetGridScale() const { return GridScale; }
+
+	const FOBGridInventoryConfig& GetGridConfig() const { return GridConfig; }
+
+	// --- Painted Items ---
+	/** Adds or replaces an item drawn by the panel itself, without a widget. */
+	void SetPaintedItem(int32 ItemId, const FOBGridPaintedItem& Item);
+	void SetPaintedItemCell(int32 ItemId, int32 Row, int32 Column);
+	void SetPaintedItemHidden(int32 ItemId, bool bHidden);
+	void RemovePaintedItem(int32 ItemId);
+	void ClearPaintedItems();
+	int32 GetNumPaintedItems() const { return PaintedItems.Num(); }
+
+	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+#if WITH_EDITOR
+	virtual const FText GetPaletteCategory() override;
+#endif
+
+protected:
+	virtual UClass* GetSlotClass() const override;
+	virtual void OnSlotAdded(UPanelSlot* InSlot) override;
+	virtual void OnSlotRemoved(UPanelSlot* InSlot) override;
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
+	/** Draw the grid lines in the panel, making a separate background widget unnecessary. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Grid")
+	bool bDrawGridLines = true;
+
+	/** Design-time layout; overwritten by the owning UOBGridInventoryWidget at runtime. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Grid")
+	FOBGridInventoryConfig GridConfig;
+
+	/** Look of items painted by the panel (see UOBGridInventoryWidget::bUsePaintedItems). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Grid")
+	FOBGridPaintedItemStyle PaintedItemStyle;
+
+	TSharedPtr<SOBGridPanel> MyGridPanel;
+
+private:
+	void PushPaintedItem(int32 ItemId) const;
+
+	float GridScale = 1.0f;
+
+	/** Kept on the UObject side so brush resources stay referenced and survive a widget rebuild. */
+	UPROPERTY(Transient)
+	TMap<int32, FOBGridPaintedItem> PaintedItems;
+};
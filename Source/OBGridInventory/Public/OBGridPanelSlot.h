@@ -0,0 +1,48 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SOBGridPanel.h"
+#include "Components/PanelSlot.h"
+#include "OBGridPanelSlot.generated.h"
+
+/** Slot of a UOBGridPanel: a cell position and a span, nothing else to lay out. */
+UCLASS()
+class OBGRIDINVENTORY_API UOBGridPanelSlot : public UPanelSlot
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Layout|OB Grid Slot")
+	void SetCell(int32 InRow, int32 InColumn);
+
+	UFUNCTION(BlueprintCallable, Category = "Layout|OB Grid Slot")
+	void SetSpan(int32 InRowSpan, int32 InColumnSpan);
+
+	int32 GetRow() const { return Row; }
+	int32 GetColumn() const { return Column; }
+	int32 GetRowSpan() const { return RowSpan; }
+	int32 GetColumnSpan() const { return ColumnSpan; }
+
+	void BuildSlot(TSharedRef<SOBGridPanel> GridPanel);
+
+	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Layout|OB Grid Slot", meta = (ClampMin = "0"))
+	int32 Row = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Layout|OB Grid Slot", meta = (ClampMin = "0"))
+	int32 Column = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Layout|OB Grid Slot", meta = (ClampMin = "1"))
+	int32 RowSpan = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Layout|OB Grid Slot", meta = (ClampMin = "1"))
+	int32 ColumnSpan = 1;
+
+private:
+	SOBGridPanel::FSlot* Slot = nullptr;
+};
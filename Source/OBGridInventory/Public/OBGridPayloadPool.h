@@ -0,0 +1,43 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StructUtils/SharedStruct.h"
+#include "StructUtils/StructView.h"
+
+/**
+ * Interns item payloads: payloads of the same struct that compare equal share one immutable FConstSharedStruct,
+ * so payload memory scales with the distinct variants rather than the item count. Hashing goes through the
+ * properties that provide a type hash; equality through UScriptStruct::CompareScriptStruct.
+ * An instance is never written to: changing an item's payload interns the new value (copy-on-write).
+ */
+class OBGRIDINVENTORY_API FOBGridPayloadPool
+{
+public:
+	/** @return The shared instance equal to Payload, one more user counted. Empty for an empty payload. */
+	FConstSharedStruct Intern(FConstStructView Payload);
+
+	/** One user fewer; the pool forgets the instance with its last user (snapshots may still hold it). */
+	void Release(const FConstSharedStruct& Payload);
+
+	void Empty();
+
+	int32 GetNumDistinct() const { return NumDistinct; }
+
+	/** Pool bookkeeping only; the shared instances are counted by whoever walks the items. */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FEntry
+	{
+		FConstSharedStruct Payload;
+		int32 NumUsers = 0;
+	};
+
+	static uint32 HashPayload(const UScriptStruct* ScriptStruct, const uint8* Memory);
+
+	/** Hash -> instances with that hash (nearly always one). */
+	TMap<uint32, TArray<FEntry, TInlineAllocator<1>>> Buckets;
+	int32 NumDistinct = 0;
+};
@@ -0,0 +1,99 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBGridOccupancy.h"
+#include "StructUtils/SharedStruct.h"
+#include <atomic>
+
+/**
+ * One placed item as seen by a snapshot. The payload is shared with other snapshots until the item changes, and
+ * with other items too when the state interns payloads.
+ */
+struct FOBGridSnapshotItem
+{
+	int32 ItemId = INDEX_NONE;
+	int32 Row = 0;
+	int32 Column = 0;
+	int32 RowSpan = 1;
+	int32 ColumnSpan = 1;
+	FConstSharedStruct Payload;
+};
+
+/**
+ * Immutable copy of an item state: occupancy, item rects and payload references. Once published it never
+ * changes, so any thread can query it without synchronization (AI, loot evaluation, server validation, or
+ * FOBGridFitSolver through GetOccupancy()).
+ */
+class OBGRIDINVENTORY_API FOBGridSnapshot
+{
+public:
+	/** Change journal sequence the snapshot reflects. Compare it with the live state to know if it is stale. */
+	int64 GetVersion() const { return Version; }
+
+	const FOBGridOccupancy& GetOccupancy() const { return Occupancy; }
+	const TArray<FOBGridSnapshotItem>& GetItems() const { return Items; }
+
+	const FOBGridSnapshotItem* FindItem(int32 ItemId) const;
+
+	/** @return The item covering the cell, or INDEX_NONE. */
+	int32 GetItemIdAtCell(int32 Row, int32 Column) const;
+
+	bool IsAreaClear(const int32 TopLeftRow, const int32 TopLeftCol, const int32 ItemRows, const int32 ItemCols,
+					 const int32 IgnoredItemId = FOBGridOccupancy::FreeCell) const
+	{
+		return Occupancy.IsAreaClear(TopLeftRow, TopLeftCol, ItemRows, ItemCols, IgnoredItemId);
+	}
+
+	bool FindFreeSlot(const int32 ItemRows, const int32 ItemCols, int32& OutRow, int32& OutCol,
+					  const int32 SectionIndex = INDEX_NONE) const
+	{
+		return Occupancy.FindFreeSlot(ItemRows, ItemCols, OutRow, OutCol, SectionIndex);
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	friend class UOBGridItemState;
+
+	int64 Version = 0;
+	FOBGridOccupancy Occupancy;
+	TArray<FOBGridSnapshotItem> Items;
+
+	/** ItemId -> index into Items. */
+	TMap<int32, int32> ItemIndices;
+};
+
+using FOBGridSnapshotPtr = TSharedPtr<const FOBGridSnapshot, ESPMode::ThreadSafe>;
+
+/**
+ * Hands the latest snapshot of an item state to any thread without locks. The game thread publishes into one of
+ * a few slots that no reader is using; a reader pins the latest slot with a counter, checks it is still the
+ * latest and copies the shared pointer out. Readers only retry when a publication lands in between.
+ * Hold the channel (not the state) on worker threads: it outlives the state.
+ */
+class OBGRIDINVENTORY_API FOBGridSnapshotChannel
+{
+public:
+	/** Any thread. Null until the first snapshot is published. */
+	FOBGridSnapshotPtr Acquire() const;
+
+	/**
+	 * Game thread only.
+	 * @return False if every spare slot is being read right now; the previous snapshot stays the latest.
+	 */
+	bool Publish(FOBGridSnapshotPtr Snapshot);
+
+private:
+	static constexpr int32 NumSlots = 4;
+
+	struct FSlot
+	{
+		FOBGridSnapshotPtr Snapshot;
+		mutable std::atomic<int32> NumReaders{0};
+	};
+
+	FSlot Slots[NumSlots];
+	std::atomic<int32> LatestSlot{INDEX_NONE};
+};
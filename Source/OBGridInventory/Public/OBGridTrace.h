@@ -0,0 +1,231 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBGridBackgroundWidget.h"
+#include "UObject/ObjectKey.h"
+#include "OBGridTrace.generated.h"
+
+struct FInstancedStruct;
+class UOBGridItemState;
+
+/** Operations a grid trace records. The arguments each one carries are listed in OBGridTrace.cpp. */
+UENUM()
+enum class EOBGridTraceOp : uint8
+{
+	InitializeGrid,
+	ResizeGrid,
+	SetGridLayout,
+	AddItem,
+	AddItemAt,
+	AddStackableItem,
+	RemoveItem,
+	MoveItem,
+	SetItemPayload,
+	ClearGrid,
+
+	/** Recorded by UOBGridItemState itself, since move authorities answer on the state directly. */
+	ReserveMove,
+	ConfirmReservation,
+	RollbackReservation,
+	Num UMETA(Hidden)
+};
+
+/** One recorded operation. Times are relative to the start of the trace. */
+struct OBGRIDINVENTORY_API FOBGridTraceEvent
+{
+	EOBGridTraceOp Op = EOBGridTraceOp::Num;
+
+	/** Identifies the item state the operation ran against; views sharing a state share the key. */
+	uint32 GridKey = 0;
+
+	int32 Args[4] = {};
+
+	/** Index into FOBGridTrace::Payloads, INDEX_NONE for operations without a payload. */
+	int32 PayloadIndex = INDEX_NONE;
+
+	/**
+	 * Ids of the items the operation placed (the reservation id for ReserveMove), so later operations can be mapped
+	 * to the replayed ids.
+	 */
+	TArray<int32> ResultItemIds;
+
+	/** New layout of InitializeGrid and SetGridLayout. */
+	TArray<FOBGridSection> Sections;
+	TArray<FIntPoint> DisabledCells;
+
+	/** Grid size when the operation started. */
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+
+	bool bSucceeded = false;
+	double StartSeconds = 0.0;
+
+	/** Includes the widget work of the view that ran the operation, not only the state update. */
+	double DurationSeconds = 0.0;
+};
+
+/** An item that was already placed when the trace first saw its grid. */
+struct FOBGridTraceItem
+{
+	int32 ItemId = INDEX_NONE;
+	int32 Row = 0;
+	int32 Column = 0;
+	int32 RowSpan = 1;
+	int32 ColumnSpan = 1;
+	int32 PayloadIndex = INDEX_NONE;
+};
+
+/** Content of a grid when the trace first saw it, so a replay starts from the same state. */
+struct FOBGridTraceGrid
+{
+	uint32 GridKey = 0;
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	TArray<FOBGridSection> Sections;
+	TArray<FIntPoint> DisabledCells;
+	TArray<FOBGridTraceItem> Items;
+};
+
+/**
+ * A loaded trace file. Payloads are stored once per distinct content (tagged property serialization, so a trace
+ * survives payload struct changes) and referenced by index from items and events.
+ */
+struct OBGRIDINVENTORY_API FOBGridTrace
+{
+	TArray<TArray<uint8>> Payloads;
+	TArray<FOBGridTraceGrid> Grids;
+	TArray<FOBGridTraceEvent> Events;
+
+	bool LoadFromFile(const FString& FilePath);
+
+	/** Rebuilds a payload. An unknown struct (renamed or removed since recording) gives an empty payload. */
+	bool LoadPayload(int32 PayloadIndex, FInstancedStruct& OutPayload) const;
+};
+
+/**
+ * Opt-in recorder of the operations called on UOBGridInventoryWidget, and of the move reservations of
+ * UOBGridItemState. Game thread only.
+ * Start it with OB.Grid.Trace.Start (or -OBGridTrace[=File] on the command line); while it is off, a traced
+ * operation costs one flag check.
+ */
+class OBGRIDINVENTORY_API FOBGridTraceRecorder
+{
+public:
+	static FOBGridTraceRecorder& Get();
+
+	static bool IsRecording() { return bRecording; }
+
+	/** Starts a new trace file, stopping the current one. An empty path picks one under Saved/Profiling. */
+	bool Start(const FString& InFilePath = FString());
+	void Stop();
+
+	const FString& GetFilePath() const { return FilePath; }
+
+private:
+	friend class FOBGridTraceScope;
+
+	int32 BeginEvent(const UOBGridItemState& State, uint32& OutGridKey);
+	void EndEvent(uint32 InSession, int32 Slot, FOBGridTraceEvent&& Event, const FInstancedStruct* Payload);
+	uint32 FindOrAddGrid(const UOBGridItemState& State);
+	int32 FindOrAddPayload(const FInstancedStruct& Payload);
+	void WriteEvent(FOBGridTraceEvent& Event);
+
+	static bool bRecording;
+
+	TUniquePtr<FArchive> Writer;
+	FString FilePath;
+	uint64 StartCycles = 0;
+	uint64 PreviousStartMicros = 0;
+
+	/** Bumped by Stop, so a scope still open across a restart does not write into the new file. */
+	uint32 Session = 0;
+
+	TMap<TObjectKey<UOBGridItemState>, uint32> GridKeys;
+
+	/** Content hash -> payload index, so repeated payloads are written once. */
+	TMap<uint64, int32> PayloadIndices;
+
+	/**
+	 * Operations started and not yet written. An operation can run another one from an event listener; events are
+	 * written in start order once the outermost one ends, which is the order a replay has to follow.
+	 */
+	TArray<TOptional<FOBGridTraceEvent>> PendingEvents;
+	int32 NumOpenScopes = 0;
+};
+
+/**
+ * Records one operation for its lifetime. Put it after the view-side validation, right before the state is
+ * touched, so the trace only holds operations that reached the item state.
+ */
+class OBGRIDINVENTORY_API FOBGridTraceScope
+{
+public:
+	FOBGridTraceScope(const UOBGridItemState* State, EOBGridTraceOp Op, int32 Arg0 = 0, int32 Arg1 = 0,
+					  int32 Arg2 = 0, int32 Arg3 = 0);
+	~FOBGridTraceScope();
+
+	FOBGridTraceScope(const FOBGridTraceScope&) = delete;
+	FOBGridTraceScope& operator=(const FOBGridTraceScope&) = delete;
+
+	/** The payload is read when the scope ends and must outlive it. */
+	void SetPayload(const FInstancedStruct& InPayload);
+	void SetLayout(const TArray<FOBGridSection>& Sections, const TArray<FIntPoint>& DisabledCells);
+	void SetSucceeded(bool bSucceeded);
+
+	/** Success is ItemId != INDEX_NONE. */
+	void SetResult(int32 ItemId);
+	void SetResult(bool bSucceeded, const TArray<int32>& ItemIds);
+
+private:
+	FOBGridTraceEvent Event;
+	const FInstancedStruct* Payload = nullptr;
+	uint64 StartCycles = 0;
+	uint32 Session = 0;
+	int32 Slot = INDEX_NONE;
+};
+
+/** Latency distribution of one operation type over a replay, in microseconds. */
+struct FOBGridTraceOpStats
+{
+	EOBGridTraceOp Op = EOBGridTraceOp::Num;
+	int32 Count = 0;
+
+	/** Operations whose outcome differs from the recording, i.e. the replay diverged. */
+	int32 NumMismatches = 0;
+
+	double MeanMicros = 0.0;
+	double P50Micros = 0.0;
+	double P90Micros = 0.0;
+	double P99Micros = 0.0;
+	double MaxMicros = 0.0;
+
+	/** The same percentiles as recorded live. They include the widget work of the view. */
+	double RecordedP50Micros = 0.0;
+	double RecordedP99Micros = 0.0;
+};
+
+/**
+ * Re-executes a trace against fresh UOBGridItemState objects and measures every operation. Runs headless: the
+ * item states are the part of the grid that does not need Slate, so view-side work is only in the recorded times.
+ */
+class OBGRIDINVENTORY_API FOBGridTraceReplayer
+{
+public:
+	/** Replays the whole trace Iterations times, each time from the recorded starting state. */
+	static bool Replay(const FOBGridTrace& Trace, int32 Iterations, TArray<FOBGridTraceOpStats>& OutStats);
+
+	static void PrintReport(const TArray<FOBGridTraceOpStats>& Stats, FOutputDevice& Ar);
+	static FString ToCsv(const TArray<FOBGridTraceOpStats>& Stats);
+};
+
+namespace OBGridTrace
+{
+	/** Starts recording when -OBGridTrace[=File] is on the command line. Called by the module. */
+	void StartFromCommandLine();
+
+	/** Loads, replays and prints the report of a trace file. Shared by the console command and the commandlet. */
+	OBGRIDINVENTORY_API bool ReplayFile(const FString& FilePath, int32 Iterations, FOutputDevice& Ar,
+										TArray<FOBGridTraceOpStats>& OutStats);
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBGridItemVisual.h"
+#include "Layout/Children.h"
+#include "SlotBase.h"
+#include "Widgets/SPanel.h"
+
+/**
+ * Slate panel specialised for uniform inventory grids.
+ * Each child is placed directly at (Column, Row) * scaled CellSize with its span, so arrange is O(children)
+ * with no fill distribution, and the desired size is simply the grid size. Grid lines and painted items are
+ * drawn by the panel itself underneath its children.
+ */
+class OBGRIDINVENTORY_API SOBGridPanel : public SPanel
+{
+public:
+	class OBGRIDINVENTORY_API FSlot : public TSlotBase<FSlot>
+	{
+	public:
+		SLATE_SLOT_BEGIN_ARGS(FSlot, TSlotBase<FSlot>)
+			SLATE_ARGUMENT(TOptional<int32>, Row)
+			SLATE_ARGUMENT(TOptional<int32>, Column)
+			SLATE_ARGUMENT(TOptional<int32>, RowSpan)
+			SLATE_ARGUMENT(TOptional<int32>, ColumnSpan)
+		SLATE_SLOT_END_ARGS()
+
+		void Construct(const FChildren& SlotOwner, FSlotArguments&& InArgs);
+
+		int32 GetRow() const { return Row; }
+		int32 GetColumn() const { return Column; }
+		int32 GetRowSpan() const { return RowSpan; }
+		int32 GetColumnSpan() const { return ColumnSpan; }
+
+		void SetCell(int32 InRow, int32 InColumn);
+		void SetSpan(int32 InRowSpan, int32 InColumnSpan);
+
+	private:
+		void InvalidateOwnerLayout() const;
+
+		int32 Row = 0;
+		int32 Column = 0;
+		int32 RowSpan = 1;
+		int32 ColumnSpan = 1;
+	};
+
+	SLATE_BEGIN_ARGS(SOBGridPanel)
+		: _NumRows(1)
+		, _NumColumns(1)
+		, _CellSize(50.0f)
+		{
+			_Visibility = EVisibility::SelfHitTestInvisible;
+		}
+		SLATE_SLOT_ARGUMENT(FSlot, Slots)
+		SLATE_ARGUMENT(int32, NumRows)
+		SLATE_ARGUMENT(int32, NumColumns)
+		SLATE_ARGUMENT(float, CellSize)
+	SLATE_END_ARGS()
+
+	SOBGridPanel();
+
+	static FSlot::FSlotArguments Slot();
+
+	void Construct(const FArguments& InArgs);
+
+	using FScopedWidgetSlotArguments = TPanelChildren<FSlot>::FScopedWidgetSlotArguments;
+	FScopedWidgetSlotArguments AddSlot(int32 Row, int32 Column, int32 RowSpan = 1, int32 ColumnSpan = 1);
+	int32 RemoveSlot(const TSharedRef<SWidget>& SlotWidget);
+	void ClearChildren();
+
+	void SetGridSize(int32 InNumRows, int32 InNumColumns);
+	void SetCellSize(float InCellSize);
+	void SetGridScale(float InGridScale);
+
+	/** Line style; thicknesses are in unscaled cell units and get scaled like the cells. */
+	void SetGridLines(bool bInDrawGridLines, const FLinearColor& InGridLineColor, float InGridLineThickness,
+					  const FLinearColor& InBorderLineColor, float InBorderLineThickness);
+
+	/** Row-major section index per cell (INDEX_NONE = masked), see FOBGridInventoryConfig::BuildCellSections. */
+	void SetCellSections(TArray<int32> InCellSections);
+
+	float GetScaledCellSize() const { return CellSize * GridScale; }
+
+	// --- Painted Items ---
+	void SetPaintedItemStyle(const FOBGridPaintedItemStyle& InStyle);
+	void SetPaintedItem(int32 ItemId, const FOBGridPaintedItem& Item);
+	void RemovePaintedItem(int32 ItemId);
+	void ClearPaintedItems();
+
+	// --- SWidget ---
+	virtual void OnArrangeChildren(const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const override;
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+						  FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
+						  bool bParentEnabled) const override;
+	virtual FChildren* GetChildren() override;
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+	TPanelChildren<FSlot> Children;
+
+	int32 NumRows = 1;
+	int32 NumColumns = 1;
+	float CellSize = 50.0f;
+	float GridScale = 1.0f;
+
+	bool bDrawGridLines = false;
+	FLinearColor GridLineColor = FLinearColor(0.1f, 0.1f, 0.1f, 0.5f);
+	FLinearColor BorderLineColor = FLinearColor(0.05f, 0.05f, 0.05f, 0.8f);
+	float GridLineThickness = 1.0f;
+	float BorderLineThickness = 2.0f;
+	TArray<int32> CellSections;
+
+	TMap<int32, FOBGridPaintedItem> PaintedItems;
+	FOBGridPaintedItemStyle PaintedItemStyle;
+};